@@ -0,0 +1,92 @@
+/**
+ * @file aleatorio.c
+ * @brief Definiciones del generador por hilo y de las distribuciones de llegada.
+ *
+ * @date 16 de octubre de 2026 (creación)
+ * @version 1.0
+ * @authors
+ * Julio López
+ */
+
+#include <math.h>
+#include <string.h>
+#include "aleatorio.h"
+
+#define PCG_MULTIPLIER  6364136223846793005ULL
+
+static const char *arrivalNames[ARRIVAL_COUNT] = {
+    "uniforme", "exponencial", "rafagas"
+};
+
+void seedRng(Rng *rng, uint64_t seed, uint64_t stream) {
+    rng->state = 0;
+    rng->inc = (stream << 1) | 1;
+    nextRandom(rng);
+    rng->state += seed;
+    nextRandom(rng);
+}
+
+uint32_t nextRandom(Rng *rng) {
+    uint64_t old = rng->state;
+    rng->state = old * PCG_MULTIPLIER + rng->inc;
+    uint32_t xorshifted = (uint32_t)(((old >> 18) ^ old) >> 27);
+    uint32_t rot = (uint32_t)(old >> 59);
+    return (xorshifted >> rot) | (xorshifted << ((-rot) & 31));
+}
+
+uint32_t randomBelow(Rng *rng, uint32_t n) {
+    // Se descartan los valores del último tramo incompleto para que no haya sesgo.
+    uint32_t threshold = (0u - n) % n;
+    uint32_t r;
+    do {
+        r = nextRandom(rng);
+    } while (r < threshold);
+    return r % n;
+}
+
+double randomUnit(Rng *rng) {
+    return nextRandom(rng) * (1.0 / 4294967296.0);
+}
+
+// Espera exponencial con el promedio indicado.
+static double exponentialGap(Rng *rng, double mean) {
+    return -mean * log(1.0 - randomUnit(rng));
+}
+
+long long arrivalGap(Rng *rng, ArrivalKind kind, int min, int spread) {
+    double mean = min + (spread - 1) / 2.0;
+    double gap;
+
+    switch (kind) {
+    case ARRIVAL_EXPONENTIAL:
+        gap = exponentialGap(rng, mean);
+        break;
+
+    case ARRIVAL_BURSTY:
+        // Cada espera sigue la ráfaga con probabilidad (BURST_LENGTH - 1) / BURST_LENGTH. La pausa que la
+        // cierra dura lo necesario para que el promedio de un ciclo completo siga siendo "mean".
+        if (randomBelow(rng, BURST_LENGTH) != 0) {
+            gap = exponentialGap(rng, mean / BURST_SPEEDUP);
+        } else {
+            gap = exponentialGap(rng, mean * (BURST_LENGTH - (BURST_LENGTH - 1.0) / BURST_SPEEDUP));
+        }
+        break;
+
+    default:
+        return min + randomBelow(rng, (uint32_t)spread);
+    }
+    return (gap >= 1) ? (long long)gap : 1;
+}
+
+const char* arrivalName(ArrivalKind kind) {
+    return (kind >= 0 && kind < ARRIVAL_COUNT) ? arrivalNames[kind] : "?";
+}
+
+int findArrival(const char *name) {
+    for (int i = 0; i < ARRIVAL_COUNT; i++) {
+        if (strcmp(name, arrivalNames[i]) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
@@ -0,0 +1,118 @@
+/**
+ * @file aleatorio.h
+ * @brief Generador de números aleatorios por hilo y distribuciones de la espera entre llegadas.
+ *
+ * @details
+ * Cada fuente de llegadas (un hilo productor o un lado de la simulación) tiene su propio generador PCG32: el
+ * estado es de quien lo usa, así que no hay estado global compartido ni bloqueos como con rand(). Todos los
+ * generadores de una corrida parten de la misma semilla y se diferencian por el número de flujo, que da
+ * secuencias independientes; con la misma semilla una corrida repite exactamente las mismas llegadas.
+ *
+ * Distribuciones de la espera entre llegadas, todas con la misma espera promedio min + (spread - 1) / 2:
+ *  - uniforme: uniforme en [min, min + spread), el comportamiento original.
+ *  - exponencial: llegadas de Poisson.
+ *  - rafagas: la mayoría de las esperas son cortas (BURST_SPEEDUP veces menores que el promedio) y cada
+ *    tanto llega una pausa larga que compensa; en promedio llegan BURST_LENGTH vehículos por ráfaga.
+ *
+ * @date 16 de octubre de 2026 (creación)
+ * @version 1.0
+ * @authors
+ * Julio López
+ */
+
+#ifndef ALEATORIO_H
+#define ALEATORIO_H
+
+#include <stdint.h>
+
+#define BURST_LENGTH    8       // Vehículos por ráfaga en promedio
+#define BURST_SPEEDUP   4       // Cuánto más seguido llegan dentro de una ráfaga
+
+/**
+ * @brief Estado de un generador PCG32.
+ */
+typedef struct {
+    uint64_t state;     /**< Estado interno */
+    uint64_t inc;       /**< Incremento impar, elige el flujo */
+} Rng;
+
+/**
+ * @brief Distribuciones de la espera entre llegadas, en el orden en que se listan con arrivalName().
+ */
+typedef enum {
+    ARRIVAL_UNIFORM,        /**< "uniforme" */
+    ARRIVAL_EXPONENTIAL,    /**< "exponencial" */
+    ARRIVAL_BURSTY,         /**< "rafagas" */
+    ARRIVAL_COUNT
+} ArrivalKind;
+
+
+/**
+ * @brief Inicializa un generador.
+ *
+ * @param rng Generador a inicializar
+ * @param seed Semilla de la corrida
+ * @param stream Número de flujo; flujos distintos con la misma semilla dan secuencias independientes
+ */
+void seedRng(Rng *rng, uint64_t seed, uint64_t stream);
+
+
+/**
+ * @brief Siguiente número de 32 bits.
+ *
+ * @param rng Generador
+ * @return uint32_t
+ */
+uint32_t nextRandom(Rng *rng);
+
+
+/**
+ * @brief Entero uniforme en [0, n).
+ *
+ * @param rng Generador
+ * @param n Cota, mayor que 0
+ * @return uint32_t
+ */
+uint32_t randomBelow(Rng *rng, uint32_t n);
+
+
+/**
+ * @brief Real uniforme en [0, 1).
+ *
+ * @param rng Generador
+ * @return double
+ */
+double randomUnit(Rng *rng);
+
+
+/**
+ * @brief Espera hasta la próxima llegada.
+ *
+ * @param rng Generador de la fuente de llegadas
+ * @param kind Distribución
+ * @param min Espera mínima de la distribución uniforme (us)
+ * @param spread Rango de la parte aleatoria de la distribución uniforme (us)
+ * @return long long Espera en microsegundos, al menos 1
+ */
+long long arrivalGap(Rng *rng, ArrivalKind kind, int min, int spread);
+
+
+/**
+ * @brief Nombre de una distribución, el que se usa en la línea de comandos y en el barrido.
+ *
+ * @param kind Distribución
+ * @return const char*
+ */
+const char* arrivalName(ArrivalKind kind);
+
+
+/**
+ * @brief Busca una distribución por nombre.
+ *
+ * @param name Nombre
+ * @return int La distribución, o -1 si el nombre no existe
+ */
+int findArrival(const char *name);
+
+
+#endif
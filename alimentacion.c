@@ -0,0 +1,242 @@
+/**
+ * @file alimentacion.c
+ * @brief Definiciones de los anillos de llegadas en memoria compartida.
+ *
+ * @date 16 de octubre de 2026 (creación)
+ * @version 1.0
+ * @authors
+ * Julio López
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <signal.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "alimentacion.h"
+
+static void segmentName(char *out, const char *name) {
+    snprintf(out, FEED_NAME_SIZE, "%s%s", (name[0] == '/') ? "" : "/", name);
+}
+
+// Diferencia entre dos posiciones que pueden haber dado la vuelta del entero.
+static int distance(int a, int b) {
+    return (int)((unsigned)a - (unsigned)b);
+}
+
+static int nextPosition(int pos) {
+    return (int)((unsigned)pos + 1u);
+}
+
+#define ABANDONED   (-1)    // pid de un espacio que el puente dio por abandonado
+
+// Reclamo de un espacio: la posición y el pid de quien la escribe, así uno de otra vuelta nunca coincide.
+static long long claimOf(int pos, int pid) {
+    return (long long)(((uint64_t)(uint32_t)pos << 32) | (uint32_t)pid);
+}
+
+static int claimPid(long long claim) {
+    return (int)(uint32_t)claim;
+}
+
+// ATOMIC_CAS_LL puede fallar sin que el valor haya cambiado; solo se rinde si de verdad era otro.
+static int swapClaim(ATOMIC_LLONG *ptr, long long expected, long long desired) {
+    long long seen = expected;
+    while (!ATOMIC_CAS_LL(ptr, &seen, desired)) {
+        if (seen != expected) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+static int processGone(int pid) {
+    return kill(pid, 0) != 0 && errno == ESRCH;
+}
+
+// Un segmento existente se puede reemplazar si no es de un puente, si su puente terminó o si ya no existe.
+static int staleFeed(const char *name) {
+    int fd = shm_open(name, O_RDONLY, 0);
+    if (fd < 0) {
+        return errno == ENOENT;
+    }
+    struct stat st;
+    int stale = 1;
+    if (fstat(fd, &st) == 0 && (size_t)st.st_size >= sizeof(FeedSegment)) {
+        FeedSegment *s = mmap(NULL, sizeof(FeedSegment), PROT_READ, MAP_SHARED, fd, 0);
+        if (s != MAP_FAILED) {
+            stale = memcmp(s->magic, FEED_MAGIC, sizeof(s->magic)) != 0 || ATOMIC_LOAD(&s->closing) ||
+                    processGone(s->pid);
+            munmap(s, sizeof(FeedSegment));
+        }
+    }
+    close(fd);
+    return stale;
+}
+
+int createFeed(Alimentacion *feed, const char *name) {
+    memset(feed, 0, sizeof(Alimentacion));
+    segmentName(feed->name, name);
+    // O_EXCL: truncar el segmento de un puente que corre dejaría a sus alimentadores con un mapeo inválido.
+    int fd = shm_open(feed->name, O_RDWR | O_CREAT | O_EXCL, 0600);
+    if (fd < 0 && errno == EEXIST) {
+        if (!staleFeed(feed->name)) {
+            errno = EEXIST;
+            return -1;
+        }
+        shm_unlink(feed->name);     // Los que lo tengan mapeado lo conservan; el nombre pasa al segmento nuevo.
+        fd = shm_open(feed->name, O_RDWR | O_CREAT | O_EXCL, 0600);
+    }
+    if (fd < 0) {
+        return -1;
+    }
+    if (ftruncate(fd, sizeof(FeedSegment)) != 0) {
+        close(fd);
+        shm_unlink(feed->name);
+        return -1;
+    }
+    void *map = mmap(NULL, sizeof(FeedSegment), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) {
+        shm_unlink(feed->name);
+        return -1;
+    }
+
+    // El segmento recién creado está en ceros; la marca va al final para que un alimentador que se conecta
+    // entre medio lo rechace en vez de usar anillos a medio inicializar.
+    FeedSegment *s = (FeedSegment*)map;
+    s->version = FEED_VERSION;
+    s->size = sizeof(FeedSegment);
+    s->pid = (int32_t)getpid();
+    for (int side = 1; side <= 2; side++) {
+        FeedRing *ring = &s->rings[side];
+        for (int i = 0; i < FEED_RING_SIZE; i++) {
+            ATOMIC_STORE_RLX(&ring->slots[i].seq, i);
+            ATOMIC_STORE_RLX(&ring->slots[i].claim, claimOf(i, 0));
+        }
+        if (sem_init(&ring->items, 1, 0) != 0) {
+            munmap(map, sizeof(FeedSegment));
+            shm_unlink(feed->name);
+            return -1;
+        }
+    }
+    ATOMIC_FENCE_REL();
+    memcpy(s->magic, FEED_MAGIC, sizeof(s->magic));
+    feed->segment = s;
+    feed->owner = 1;
+    return 0;
+}
+
+int attachFeed(Alimentacion *feed, const char *name) {
+    memset(feed, 0, sizeof(Alimentacion));
+    segmentName(feed->name, name);
+    int fd = shm_open(feed->name, O_RDWR, 0);
+    if (fd < 0) {
+        return -1;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(FeedSegment)) {
+        close(fd);
+        return -1;
+    }
+    void *map = mmap(NULL, sizeof(FeedSegment), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) {
+        return -1;
+    }
+    FeedSegment *s = (FeedSegment*)map;
+    ATOMIC_FENCE_ACQ();
+    if (memcmp(s->magic, FEED_MAGIC, sizeof(s->magic)) != 0 || s->version != FEED_VERSION ||
+        s->size != sizeof(FeedSegment) || ATOMIC_LOAD(&s->closing)) {
+        munmap(map, sizeof(FeedSegment));
+        return -1;
+    }
+    ATOMIC_ADD(&s->attached, 1);
+    ATOMIC_ADD(&s->attachments, 1);
+    feed->segment = s;
+    return 0;
+}
+
+int feedPush(Alimentacion *feed, int side, const FeedRecord *record) {
+    FeedRing *ring = &feed->segment->rings[side];
+    int pos = ATOMIC_LOAD_RLX(&ring->tail);
+    FeedSlot *slot;
+    while (1) {
+        slot = &ring->slots[pos & (FEED_RING_SIZE - 1)];
+        int diff = distance(ATOMIC_LOAD_ACQ(&slot->seq), pos);
+        if (diff == 0) {
+            if (ATOMIC_CAS(&ring->tail, &pos, nextPosition(pos))) {
+                break;              // Espacio reservado; si falla, pos queda con la cola actual.
+            }
+        } else if (diff < 0) {
+            ATOMIC_ADD(&ring->dropped, 1);
+            return 0;               // El puente todavía no leyó este espacio de la vuelta anterior.
+        } else {
+            pos = ATOMIC_LOAD_RLX(&ring->tail);     // Otro alimentador lo reservó primero.
+        }
+    }
+    // Si el puente ya lo dio por abandonado (este proceso tardó más de FEED_STALL_US en llegar aquí), el espacio
+    // puede ser de otro alimentador en la vuelta siguiente: no se escribe.
+    if (!swapClaim(&slot->claim, claimOf(pos, 0), claimOf(pos, (int)getpid()))) {
+        ATOMIC_ADD(&ring->dropped, 1);
+        return 0;
+    }
+    slot->record = *record;
+    ATOMIC_STORE_REL(&slot->seq, nextPosition(pos));
+    ATOMIC_ADD(&ring->sent, 1);
+    sem_post(&ring->items);
+    return 1;
+}
+
+int feedPop(Alimentacion *feed, int side, FeedRecord *record) {
+    FeedRing *ring = &feed->segment->rings[side];
+    int pos = ATOMIC_LOAD_RLX(&ring->head);
+    FeedSlot *slot = &ring->slots[pos & (FEED_RING_SIZE - 1)];
+    if (ATOMIC_LOAD_ACQ(&slot->seq) != nextPosition(pos)) {
+        return 0;       // Reservado pero todavía no publicado.
+    }
+    *record = slot->record;
+    ATOMIC_STORE_RLX(&slot->claim, claimOf((int)((unsigned)pos + FEED_RING_SIZE), 0));
+    ATOMIC_STORE_REL(&slot->seq, (int)((unsigned)pos + FEED_RING_SIZE));   // Libre para la próxima vuelta.
+    ATOMIC_STORE_REL(&ring->head, nextPosition(pos));
+    return 1;
+}
+
+int feedReclaim(Alimentacion *feed, int side) {
+    FeedRing *ring = &feed->segment->rings[side];
+    int pos = ATOMIC_LOAD_RLX(&ring->head);
+    FeedSlot *slot = &ring->slots[pos & (FEED_RING_SIZE - 1)];
+    if (ATOMIC_LOAD_ACQ(&slot->seq) != pos || distance(ATOMIC_LOAD(&ring->tail), pos) <= 0) {
+        return 0;       // Ya publicado, o todavía no lo reservó nadie.
+    }
+    long long claim = ATOMIC_LOAD_ACQ(&slot->claim);
+    if (claimPid(claim) != 0 && !processGone(claimPid(claim))) {
+        return 0;       // Lo está escribiendo un alimentador vivo.
+    }
+    // Si un alimentador lo reclama justo ahora, gana él y el espacio se publicará.
+    if (!swapClaim(&slot->claim, claim, claimOf(pos, ABANDONED))) {
+        return 0;
+    }
+    ATOMIC_STORE_RLX(&slot->claim, claimOf((int)((unsigned)pos + FEED_RING_SIZE), 0));
+    ATOMIC_STORE_REL(&slot->seq, (int)((unsigned)pos + FEED_RING_SIZE));
+    ATOMIC_STORE_REL(&ring->head, nextPosition(pos));
+    ATOMIC_ADD(&ring->abandoned, 1);
+    return 1;
+}
+
+void closeFeed(Alimentacion *feed) {
+    if (feed->segment == NULL) {
+        return;
+    }
+    if (feed->owner) {
+        ATOMIC_STORE(&feed->segment->closing, 1);
+        shm_unlink(feed->name);
+    } else {
+        ATOMIC_ADD(&feed->segment->attached, -1);
+    }
+    munmap(feed->segment, sizeof(FeedSegment));
+    feed->segment = NULL;
+}
@@ -0,0 +1,174 @@
+/**
+ * @file alimentacion.h
+ * @brief Anillos en memoria compartida para que procesos alimentadores entreguen llegadas al puente.
+ *
+ * @details
+ * Con "main -A nombre" las llegadas no las genera un hilo del proceso: las envían procesos alimentadores
+ * (programa alimentador) que se conectan al segmento de memoria compartida POSIX "nombre" cuando quieren y se
+ * desconectan cuando quieren, mientras el puente sigue corriendo. El segmento tiene un anillo por lado.
+ *
+ * Cada anillo es una cola acotada de varios productores y un consumidor sin bloqueos (un número de secuencia
+ * por espacio): un alimentador reserva un espacio con una comparación e intercambio, escribe el registro
+ * directamente en la memoria compartida y lo publica con la secuencia, sin copias intermedias ni syscalls.
+ * Después despierta al consumidor con un semáforo compartido entre procesos (sem_init con pshared = 1, que en
+ * Linux es un futex en el mismo segmento). Como ningún alimentador toma un bloqueo, uno que muere no deja a
+ * los demás ni al puente esperando.
+ *
+ * El único punto delicado es un alimentador que muere (SIGKILL, caída) entre reservar un espacio y publicarlo:
+ * el puente lee en orden y se quedaría esperando ese espacio. Por eso, después de reservar, el alimentador
+ * reclama el espacio con una comparación e intercambio que escribe la posición y su pid, y recién entonces
+ * escribe el registro. Si el espacio de la cabeza sigue sin publicar después de FEED_STALL_US, el puente lo da
+ * por abandonado (feedReclaim()) cuando nadie lo reclamó o cuando el proceso que lo reclamó ya no existe, y lo
+ * salta. Como el reclamo lleva la posición, un alimentador que tarda y llega después pierde esa llegada en vez
+ * de escribir el espacio que ya es de la vuelta siguiente.
+ *
+ * Un segundo puente con el mismo nombre no reemplaza el segmento de uno que sigue corriendo.
+ *
+ * Del lado del puente, un hilo por lado toma los registros y los entrega a la cola de espera de siempre,
+ * como lo hacía arrivalScheduler(): es el único productor de esa cola, y el resto del puente no cambia.
+ *
+ * @date 16 de octubre de 2026 (creación)
+ * @version 1.0
+ * @authors
+ * Julio López
+ */
+
+#ifndef ALIMENTACION_H
+#define ALIMENTACION_H
+
+#include <stdint.h>
+#include <semaphore.h>
+#include "funciones.h"
+
+#define FEED_MAGIC          "PUENTEAL"
+#define FEED_VERSION        2
+#define FEED_RING_SIZE      1024        // Registros por anillo, potencia de 2
+#define FEED_NAME_SIZE      64
+#define FEED_POLL_US        100000      // Cada cuánto el hilo de entrada revisa si la corrida terminó
+#define FEED_SPIN_US        1000        // Espera activa por un espacio reservado; después, pausas de este largo
+#define FEED_STALL_US       100000      // Espera por un espacio reservado antes de revisar a su alimentador
+
+/**
+ * @brief Una llegada enviada por un alimentador.
+ */
+typedef struct {
+    int64_t sent;       /**< Instante del envío, CLOCK_MONOTONIC en microsegundos */
+    int32_t feeder;     /**< Proceso que la envió */
+    int32_t priority;   /**< 1 si es un vehículo de emergencia */
+} FeedRecord;
+
+/**
+ * @brief Un espacio del anillo: su secuencia dice si está libre para la vuelta actual o listo para leer.
+ */
+typedef struct {
+    ATOMIC_INT seq;     /**< pos: libre para escribir la posición pos; pos + 1: listo para leer */
+    ATOMIC_LLONG claim; /**< Posición (32 bits altos) y pid de quien la escribe (bajos; 0: nadie, -1: abandonada) */
+    FeedRecord record;  /**< Registro */
+} FeedSlot;
+
+/**
+ * @brief Anillo de un lado.
+ */
+typedef struct {
+    ATOMIC_INT tail;            /**< Próxima posición a reservar, la mueven los alimentadores */
+    char pad0[CACHE_LINE_SIZE - sizeof(ATOMIC_INT)];
+    ATOMIC_INT head;            /**< Próxima posición a leer, la mueve el puente */
+    char pad1[CACHE_LINE_SIZE - sizeof(ATOMIC_INT)];
+    sem_t items;                /**< Registros publicados y no leídos, compartido entre procesos */
+    ATOMIC_LLONG sent;          /**< Llegadas entregadas al anillo */
+    ATOMIC_LLONG dropped;       /**< Llegadas descartadas con el anillo lleno */
+    ATOMIC_LLONG abandoned;     /**< Espacios reservados que nunca se publicaron y el puente saltó */
+    FeedSlot slots[FEED_RING_SIZE] __attribute__((aligned(CACHE_LINE_SIZE)));
+} __attribute__((aligned(CACHE_LINE_SIZE))) FeedRing;
+
+/**
+ * @brief Contenido del segmento compartido.
+ */
+typedef struct {
+    char magic[8];              /**< FEED_MAGIC, se escribe al final de la inicialización */
+    uint32_t version;           /**< FEED_VERSION */
+    uint32_t size;              /**< sizeof(FeedSegment) */
+    int32_t pid;                /**< Proceso del puente */
+    ATOMIC_INT closing;         /**< 1 cuando el puente terminó: los alimentadores se desconectan */
+    ATOMIC_INT attached;        /**< Alimentadores conectados ahora */
+    ATOMIC_INT attachments;     /**< Conexiones desde el inicio */
+    FeedRing rings[3];          /**< Anillo de cada lado (índices 1 y 2) */
+} FeedSegment;
+
+/**
+ * @brief Segmento abierto por el puente o por un alimentador.
+ */
+typedef struct {
+    FeedSegment *segment;       /**< Segmento mapeado */
+    char name[FEED_NAME_SIZE];  /**< Nombre para shm_open(), empieza con '/' */
+    int owner;                  /**< 1 si lo creó este proceso (el puente) */
+} Alimentacion;
+
+
+/**
+ * @brief Crea el segmento del puente. Si ya existe uno con el nombre, lo reemplaza solo si el puente que lo
+ * creó terminó o ya no existe; nunca toca el segmento de un puente que sigue corriendo.
+ *
+ * @param feed Segmento a inicializar
+ * @param name Nombre; si no empieza con '/' se le agrega
+ * @return 0 si todo salió bien, -1 si no (errno indica la causa; EEXIST si otro puente usa el nombre)
+ */
+int createFeed(Alimentacion *feed, const char *name);
+
+
+/**
+ * @brief Conecta un alimentador a un puente que está corriendo.
+ *
+ * @param feed Segmento a inicializar
+ * @param name Nombre; si no empieza con '/' se le agrega
+ * @return 0 si todo salió bien, -1 si no hay un puente con ese nombre
+ */
+int attachFeed(Alimentacion *feed, const char *name);
+
+
+/**
+ * @brief Envía una llegada al anillo de un lado. Pueden llamarla varios procesos a la vez.
+ *
+ * @param feed Segmento conectado
+ * @param side 1 izquierda, 2 derecha
+ * @param record Llegada
+ * @return 1 si se entregó, 0 si el anillo estaba lleno o el puente dio el espacio por abandonado (la llegada
+ * se cuenta como descartada)
+ */
+int feedPush(Alimentacion *feed, int side, const FeedRecord *record);
+
+
+/**
+ * @brief Toma la llegada más antigua de un lado. Solo la llama el hilo de entrada de ese lado, después de
+ * reservar un registro con el semáforo "items" del anillo.
+ *
+ * @param feed Segmento del puente
+ * @param side 1 izquierda, 2 derecha
+ * @param record Llegada leída
+ * @return 1 si había una llegada publicada, 0 si no
+ */
+int feedPop(Alimentacion *feed, int side, FeedRecord *record);
+
+
+/**
+ * @brief Salta el espacio de la cabeza si está reservado y no se publicará: nadie lo reclamó todavía, o lo
+ * reclamó un proceso que ya no existe. Solo la llama el hilo de entrada del lado, después de esperar el
+ * espacio FEED_STALL_US.
+ *
+ * @param feed Segmento del puente
+ * @param side 1 izquierda, 2 derecha
+ * @return 1 si el espacio se saltó, 0 si hay que seguir esperándolo
+ */
+int feedReclaim(Alimentacion *feed, int side);
+
+
+/**
+ * @brief Desconecta un alimentador, o en el puente avisa a los alimentadores que terminó y borra el nombre
+ * del segmento. Los procesos que siguen conectados conservan su mapeo hasta desconectarse.
+ *
+ * @param feed Segmento abierto
+ */
+void closeFeed(Alimentacion *feed);
+
+
+#endif
@@ -0,0 +1,152 @@
+/**
+ * @file alimentador.c
+ * @brief Proceso que genera llegadas y las envía a un puente que corre con main -A.
+ *
+ * @details
+ * Se conecta al segmento de alimentación (ver alimentacion.h), genera llegadas en uno o los dos lados con las
+ * distribuciones de aleatorio.h y las entrega a los anillos compartidos. Se pueden lanzar y detener
+ * alimentadores en cualquier momento mientras el puente corre; con SIGINT o SIGTERM se desconecta y termina,
+ * y también termina cuando el puente termina o después de -n llegadas. Al final imprime lo enviado y lo
+ * descartado por anillo lleno.
+ *
+ * @date 16 de octubre de 2026 (creación)
+ * @version 1.0
+ * @authors
+ * Julio López
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <signal.h>
+#include <unistd.h>
+#include <time.h>
+#include "alimentacion.h"
+#include "aleatorio.h"
+
+#define FEEDER_MIN_US       500000      // Espera mínima entre llegadas por lado (la de main)
+#define FEEDER_SPREAD_US    1500000     // Rango de la parte aleatoria de la espera
+
+static volatile sig_atomic_t stopRequested = 0;
+
+static void onStop(int sig) {
+    (void)sig;
+    stopRequested = 1;
+}
+
+static long long monotonicUs() {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec * 1000000LL + now.tv_nsec / 1000;
+}
+
+// Duerme hasta un instante absoluto; una señal corta la espera para revisar stopRequested.
+static void sleepUntil(long long us) {
+    struct timespec deadline;
+    deadline.tv_sec = us / 1000000;
+    deadline.tv_nsec = (us % 1000000) * 1000;
+    clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, NULL);
+}
+
+static void usage(const char *prog) {
+    fprintf(stderr, "Uso: %s [-l lado] [-d distribucion] [-m minimo] [-x dispersion] [-r semilla] [-n llegadas]\n"
+                    "       [-e porcentaje] nombre\n", prog);
+    fprintf(stderr, "  -l lado       izquierda, derecha o ambos (por defecto)\n");
+    fprintf(stderr, "  -d distrib    Espera entre llegadas: uniforme (por defecto), exponencial, rafagas\n");
+    fprintf(stderr, "  -m minimo     Espera mínima entre llegadas de un lado en us (por defecto %d)\n", FEEDER_MIN_US);
+    fprintf(stderr, "  -x dispersion Rango de la parte aleatoria de la espera en us (por defecto %d)\n",
+            FEEDER_SPREAD_US);
+    fprintf(stderr, "  -r semilla    Semilla (por defecto el número de proceso)\n");
+    fprintf(stderr, "  -n llegadas   Termina después de esta cantidad (por defecto, cuando termina el puente)\n");
+    fprintf(stderr, "  -e porcentaje Porcentaje de llegadas que son emergencias (por defecto 0)\n");
+    fprintf(stderr, "  nombre        Segmento del puente, el mismo de main -A\n");
+}
+
+int main(int argc, char *argv[]) {
+    int sides[3] = {0, 1, 1};
+    ArrivalKind kind = ARRIVAL_UNIFORM;
+    int minimum = FEEDER_MIN_US;
+    int spread = FEEDER_SPREAD_US;
+    unsigned long long seed = (unsigned long long)getpid();
+    long long limit = 0;
+    double share = 0;
+    int opt;
+    while ((opt = getopt(argc, argv, "l:d:m:x:r:n:e:")) != -1) {
+        switch (opt) {
+        case 'l':
+            sides[1] = (strcmp(optarg, "derecha") != 0);
+            sides[2] = (strcmp(optarg, "izquierda") != 0);
+            if (strcmp(optarg, "izquierda") != 0 && strcmp(optarg, "derecha") != 0 &&
+                strcmp(optarg, "ambos") != 0) {
+                usage(argv[0]);
+                return 1;
+            }
+            break;
+        case 'd':
+            if (findArrival(optarg) < 0) {
+                fprintf(stderr, "Distribución desconocida: %s\n", optarg);
+                return 1;
+            }
+            kind = (ArrivalKind)findArrival(optarg);
+            break;
+        case 'm': minimum = atoi(optarg); break;
+        case 'x': spread = atoi(optarg); break;
+        case 'r': seed = strtoull(optarg, NULL, 10); break;
+        case 'n': limit = atoll(optarg); break;
+        case 'e': share = atof(optarg) / 100.0; break;
+        default:
+            usage(argv[0]);
+            return 1;
+        }
+    }
+    if (optind >= argc || minimum < 0 || spread < 1 || share < 0 || share > 1) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    Alimentacion feed;
+    if (attachFeed(&feed, argv[optind]) != 0) {
+        fprintf(stderr, "%s: no hay un puente esperando alimentadores\n", argv[optind]);
+        return 1;
+    }
+    struct sigaction sa;
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = onStop;
+    sigaction(SIGINT, &sa, NULL);
+    sigaction(SIGTERM, &sa, NULL);
+
+    // Un generador y un plazo absoluto por lado, como las puertas de arrivalScheduler().
+    Rng rng[3];
+    long long deadline[3];
+    long long sent[3] = {0, 0, 0};
+    long long dropped[3] = {0, 0, 0};
+    long long start = monotonicUs();
+    for (int side = 1; side <= 2; side++) {
+        seedRng(&rng[side], seed, side);
+        deadline[side] = sides[side] ? start + arrivalGap(&rng[side], kind, minimum, spread) : LLONG_MAX;
+    }
+
+    long long total = 0;
+    while (!stopRequested && !ATOMIC_LOAD(&feed.segment->closing) && (limit <= 0 || total < limit)) {
+        int side = (deadline[1] <= deadline[2]) ? 1 : 2;
+        sleepUntil(deadline[side]);
+        if (stopRequested || monotonicUs() < deadline[side]) {
+            continue;   // Despertó una señal antes del plazo.
+        }
+        int priority = share > 0 && randomUnit(&rng[side]) < share;
+        FeedRecord record = {monotonicUs(), (int32_t)getpid(), priority};
+        if (feedPush(&feed, side, &record)) {
+            sent[side]++;
+        } else {
+            dropped[side]++;
+        }
+        total++;
+        deadline[side] += arrivalGap(&rng[side], kind, minimum, spread);
+    }
+
+    closeFeed(&feed);
+    printf("Alimentador %d: izquierda %lld enviadas (%lld descartadas), derecha %lld enviadas (%lld descartadas)\n",
+           (int)getpid(), sent[1], dropped[1], sent[2], dropped[2]);
+    return 0;
+}
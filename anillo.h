@@ -0,0 +1,233 @@
+/**
+ * @file anillo.h
+ * @brief Generador de buffers circulares tipados con capacidad potencia de 2.
+ *
+ * @details
+ * RING_DEFINE(Nombre, prefijo, Tipo, CAPACIDAD, VACIO, ES_VACIO, VERSIONADO) define el tipo Nombre y sus
+ * funciones prefijoCreate, prefijoAdd, prefijoRemove, etc. como static inline, especializadas para Tipo: un
+ * registro de cualquier tipo que se copia por valor, con un valor VACIO que marca los espacios libres y una
+ * macro ES_VACIO(x) que lo reconoce. funciones.h define así CircularBuffer, el buffer de enteros de las colas
+ * y del puente.
+ *
+ * CAPACIDAD es una constante potencia de 2: el arreglo va dentro de la estructura y la máscara es
+ * prefijoMask, una constante de compilación. El buffer tiene además "size" espacios lógicos, lo que ve quien
+ * lo usa, que se elige al crearlo y no puede pasar de CAPACIDAD. head y tail son posiciones que solo crecen
+ * y el espacio de una posición es pos & prefijoMask, así que ninguna operación divide. Los espacios lógicos
+ * son las posiciones [tail, tail + size) y los espacios fuera de esa ventana siempre están en VACIO: cuando
+ * tail avanza, el espacio que entra por el otro extremo ya está libre y solo una rotación tiene que mover el
+ * valor que sale. head siempre está entre tail y tail + size - 1.
+ *
+ * Con VERSIONADO en 1 cada escritura deja seq impar mientras dura (seqlock), para que otro hilo pueda copiar
+ * el estado sin bloqueo; con 0 seq no se toca.
+ *
+ * Se incluye desde funciones.h, después de atomicos.h y de CACHE_LINE_SIZE.
+ *
+ * @date 16 de octubre de 2026 (creación)
+ * @version 1.1
+ * @date 17 de octubre de 2026 (última actualización)
+ * @authors
+ * Julio López
+ *
+ * @history
+ * Versión 1.0 - 16 de octubre de 2026 - Creación del archivo.
+ * Versión 1.1 - 17 de octubre de 2026 - Capacidad de compilación, ventana lógica sin copias y seqlock opcional.
+ */
+
+#ifndef ANILLO_H
+#define ANILLO_H
+
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @brief Define un buffer circular de registros "Type" con CAPACITY espacios.
+ *
+ * Funciones generadas (prefijo p):
+ *  - Name* pCreate(int size) / void pDestroy(Name*): una sola reserva alineada, espacios en VACIO. NULL si
+ *    size no está entre 1 y CAPACITY.
+ *  - int pAdd(Name*, Type): escribe en head si ese espacio está libre; 1 si se añadió, 0 si estaba lleno.
+ *  - Type pRemove(Name*): retira el valor en tail, o VACIO sin avanzar si no hay nada.
+ *  - int pAddMany / pRemoveMany(Name*, Type*, int n): hasta n registros con dos copias contiguas y una sola
+ *    escritura del seqlock. Son para colas, donde lo ocupado está contiguo desde tail.
+ *  - Type pShift(Name*, Type): sale el valor en tail y el nuevo entra en el último espacio lógico.
+ *  - void pRotate(Name*): avanza tail; el valor que sale pasa al último espacio lógico.
+ *  - Type pPeek(Name*), Type pAt(Name*, i): el primer valor, o el i-ésimo espacio lógico desde tail.
+ *  - int pCount / pIsEmpty / pIsFull(Name*): por el contador de ocupados, en tiempo constante.
+ *
+ * Las escrituras las serializa quien usa el buffer. Un lector sin bloqueo (solo con VERSIONED) lee seq con
+ * acquire, copia con pAt() o con slots[(tail + i) & pMask], y acepta la copia si seq no cambió.
+ */
+#define RING_DEFINE(Name, p, Type, CAPACITY, EMPTY, IS_EMPTY, VERSIONED)                                   \
+    enum { p##Capacity = (CAPACITY), p##Mask = (CAPACITY) - 1 };                                          \
+    typedef char p##CapacityIsPowerOf2[(((CAPACITY) & ((CAPACITY) - 1)) == 0) ? 1 : -1];                  \
+                                                                                                            \
+    typedef struct {                                                                                        \
+        unsigned head;      /* Próxima posición a escribir */                                               \
+        unsigned tail;      /* Primera posición lógica */                                                   \
+        int size;           /* Espacios lógicos */                                                          \
+        int count;          /* Espacios ocupados */                                                         \
+        ATOMIC_INT seq;     /* Versión para lecturas sin bloqueo, si VERSIONED */                           \
+        Type slots[CAPACITY] __attribute__((aligned(CACHE_LINE_SIZE)));                                     \
+    } Name;                                                                                                 \
+                                                                                                            \
+    static inline Name* p##Create(int size) {                                                               \
+        Name *r;                                                                                            \
+        if (size < 1 || size > (CAPACITY) ||                                                                \
+            posix_memalign((void**)&r, CACHE_LINE_SIZE, sizeof(Name)) != 0) {                               \
+            return NULL;                                                                                    \
+        }                                                                                                   \
+        r->head = 0;                                                                                        \
+        r->tail = 0;                                                                                        \
+        r->size = size;                                                                                     \
+        r->count = 0;                                                                                       \
+        ATOMIC_STORE(&r->seq, 0);                                                                           \
+        for (int i = 0; i < (CAPACITY); i++) {                                                              \
+            r->slots[i] = EMPTY;                                                                            \
+        }                                                                                                   \
+        return r;                                                                                           \
+    }                                                                                                       \
+                                                                                                            \
+    static inline void p##Destroy(Name *r) {                                                                \
+        free(r);                                                                                            \
+    }                                                                                                       \
+                                                                                                            \
+    static inline int p##Count(const Name *r) {                                                             \
+        return r->count;                                                                                    \
+    }                                                                                                       \
+                                                                                                            \
+    static inline int p##IsEmpty(const Name *r) {                                                           \
+        return r->count == 0;                                                                               \
+    }                                                                                                       \
+                                                                                                            \
+    static inline int p##IsFull(const Name *r) {                                                            \
+        return r->count >= r->size;                                                                         \
+    }                                                                                                       \
+                                                                                                            \
+    static inline Type p##At(const Name *r, int i) {                                                        \
+        return r->slots[(r->tail + (unsigned)i) & p##Mask];                                                 \
+    }                                                                                                       \
+                                                                                                            \
+    static inline Type p##Peek(const Name *r) {                                                             \
+        return (r->count == 0) ? EMPTY : r->slots[r->tail & p##Mask];                                       \
+    }                                                                                                       \
+                                                                                                            \
+    /* Un solo escritor: basta con guardar seq + 1; el fence ordena ese guardado antes de los datos. */     \
+    static inline void p##BeginWrite(Name *r) {                                                             \
+        if (VERSIONED) {                                                                                    \
+            ATOMIC_STORE_RLX(&r->seq, ATOMIC_LOAD_RLX(&r->seq) + 1);                                        \
+            ATOMIC_FENCE_REL();                                                                             \
+        }                                                                                                   \
+    }                                                                                                       \
+                                                                                                            \
+    static inline void p##EndWrite(Name *r) {                                                               \
+        if (VERSIONED) {                                                                                    \
+            ATOMIC_STORE_REL(&r->seq, ATOMIC_LOAD_RLX(&r->seq) + 1);                                        \
+        }                                                                                                   \
+    }                                                                                                       \
+                                                                                                            \
+    /* Después de avanzar tail: si head quedó atrás, da la vuelta de la ventana. */                         \
+    static inline void p##Settle(Name *r) {                                                                 \
+        if (r->head - r->tail >= (unsigned)r->size) {                                                       \
+            r->head += (unsigned)r->size;                                                                   \
+        }                                                                                                   \
+    }                                                                                                       \
+                                                                                                            \
+    static inline int p##Add(Name *r, Type value) {                                                         \
+        Type *slot = &r->slots[r->head & p##Mask];                                                          \
+        if (!IS_EMPTY(*slot)) {                                                                             \
+            return 0;       /* Lleno: no se sobrescribe el espacio en head. */                              \
+        }                                                                                                   \
+        p##BeginWrite(r);                                                                                   \
+        *slot = value;                                                                                      \
+        if (++r->head - r->tail == (unsigned)r->size) {                                                     \
+            r->head = r->tail;                                                                              \
+        }                                                                                                   \
+        r->count += !IS_EMPTY(value);                                                                       \
+        p##EndWrite(r);                                                                                     \
+        return 1;                                                                                           \
+    }                                                                                                       \
+                                                                                                            \
+    static inline Type p##Remove(Name *r) {                                                                 \
+        if (r->count == 0) {                                                                                \
+            return EMPTY;   /* Vacío: tail no avanza para no desordenar la cola. */                         \
+        }                                                                                                   \
+        p##BeginWrite(r);                                                                                   \
+        Type *slot = &r->slots[r->tail & p##Mask];                                                          \
+        Type value = *slot;                                                                                 \
+        *slot = EMPTY;      /* Queda fuera de la ventana; vuelve a entrar libre. */                         \
+        r->tail++;                                                                                          \
+        p##Settle(r);                                                                                       \
+        r->count -= !IS_EMPTY(value);                                                                       \
+        p##EndWrite(r);                                                                                     \
+        return value;                                                                                       \
+    }                                                                                                       \
+                                                                                                            \
+    static inline int p##AddMany(Name *r, const Type *values, int n) {                                      \
+        if (n > r->size - r->count) {                                                                       \
+            n = r->size - r->count;                                                                         \
+        }                                                                                                   \
+        if (n <= 0) {                                                                                       \
+            return 0;                                                                                       \
+        }                                                                                                   \
+        /* Primer tramo hasta el final del arreglo, el resto desde el inicio. */                            \
+        unsigned pos = r->head & p##Mask;                                                                   \
+        unsigned first = ((unsigned)n < (CAPACITY) - pos) ? (unsigned)n : (CAPACITY) - pos;                 \
+        p##BeginWrite(r);                                                                                   \
+        memcpy(&r->slots[pos], values, first * sizeof(Type));                                               \
+        memcpy(r->slots, values + first, (n - first) * sizeof(Type));                                       \
+        r->head += (unsigned)n;                                                                             \
+        if (r->head - r->tail >= (unsigned)r->size) {                                                       \
+            r->head -= (unsigned)r->size;                                                                   \
+        }                                                                                                   \
+        r->count += n;                                                                                      \
+        p##EndWrite(r);                                                                                     \
+        return n;                                                                                           \
+    }                                                                                                       \
+                                                                                                            \
+    static inline int p##RemoveMany(Name *r, Type *out, int n) {                                            \
+        if (n > r->count) {                                                                                 \
+            n = r->count;                                                                                   \
+        }                                                                                                   \
+        if (n <= 0) {                                                                                       \
+            return 0;                                                                                       \
+        }                                                                                                   \
+        unsigned pos = r->tail & p##Mask;                                                                   \
+        unsigned first = ((unsigned)n < (CAPACITY) - pos) ? (unsigned)n : (CAPACITY) - pos;                 \
+        p##BeginWrite(r);                                                                                   \
+        memcpy(out, &r->slots[pos], first * sizeof(Type));                                                  \
+        memcpy(out + first, r->slots, (n - first) * sizeof(Type));                                          \
+        for (unsigned i = 0; i < (unsigned)n; i++) {                                                        \
+            r->slots[(pos + i) & p##Mask] = EMPTY;                                                          \
+        }                                                                                                   \
+        r->tail += (unsigned)n;                                                                             \
+        p##Settle(r);                                                                                       \
+        r->count -= n;                                                                                      \
+        p##EndWrite(r);                                                                                     \
+        return n;                                                                                           \
+    }                                                                                                       \
+                                                                                                            \
+    static inline Type p##Shift(Name *r, Type value) {                                                      \
+        p##BeginWrite(r);                                                                                   \
+        Type *slot = &r->slots[r->tail & p##Mask];                                                          \
+        Type out = *slot;                                                                                   \
+        *slot = EMPTY;                                                                                      \
+        r->tail++;                                                                                          \
+        r->slots[(r->tail + (unsigned)r->size - 1) & p##Mask] = value;                                      \
+        r->head = r->tail;                                                                                  \
+        r->count += !IS_EMPTY(value) - !IS_EMPTY(out);                                                      \
+        p##EndWrite(r);                                                                                     \
+        return out;                                                                                         \
+    }                                                                                                       \
+                                                                                                            \
+    static inline void p##Rotate(Name *r) {                                                                 \
+        p##BeginWrite(r);                                                                                   \
+        Type *slot = &r->slots[r->tail & p##Mask];                                                          \
+        Type value = *slot;                                                                                 \
+        *slot = EMPTY;                                                                                      \
+        r->tail++;                                                                                          \
+        r->slots[(r->tail + (unsigned)r->size - 1) & p##Mask] = value;                                      \
+        p##Settle(r);                                                                                       \
+        p##EndWrite(r);                                                                                     \
+    }
+
+#endif
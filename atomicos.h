@@ -0,0 +1,66 @@
+/**
+ * @file atomicos.h
+ * @brief Macros de acceso atómico con alternativa para compiladores sin <stdatomic.h>.
+ *
+ * @details
+ * Con GCC 4.9 o posterior las macros ATOMIC_* usan <stdatomic.h>; antes, las instrucciones __sync de GCC.
+ * Todo acceso a datos que comparten hilos pasa por estas macros. Lo incluyen funciones.h y estadisticas.h.
+ *
+ * @date 17 de octubre de 2026 (creación)
+ * @version 1.0
+ * @authors
+ * Julio López
+ */
+
+#ifndef ATOMICOS_H
+#define ATOMICOS_H
+
+/* Esto se hace porque Aragorn no incluye <stdatomic.h>*/
+#if __GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9)
+    #include <stdatomic.h>
+    #define ATOMIC_INT atomic_int
+    #define ATOMIC_LLONG atomic_llong
+    #define ATOMIC_LOAD(ptr) atomic_load(ptr)
+    #define ATOMIC_STORE(ptr, val) atomic_store(ptr, val)
+    #define ATOMIC_ADD(ptr, val) atomic_fetch_add(ptr, val)
+    #define ATOMIC_LOAD_RLX(ptr) atomic_load_explicit(ptr, memory_order_relaxed)
+    #define ATOMIC_LOAD_ACQ(ptr) atomic_load_explicit(ptr, memory_order_acquire)
+    #define ATOMIC_STORE_RLX(ptr, val) atomic_store_explicit(ptr, val, memory_order_relaxed)
+    #define ATOMIC_STORE_REL(ptr, val) atomic_store_explicit(ptr, val, memory_order_release)
+    #define ATOMIC_CAS(ptr, expected, desired) atomic_compare_exchange_weak(ptr, expected, desired)
+    #define ATOMIC_CAS_LL(ptr, expected, desired) atomic_compare_exchange_weak(ptr, expected, desired)
+    #define ATOMIC_FENCE_ACQ() atomic_thread_fence(memory_order_acquire)
+    #define ATOMIC_FENCE_REL() atomic_thread_fence(memory_order_release)
+#else
+    #define ATOMIC_INT volatile int
+    #define ATOMIC_LLONG volatile long long
+    #define ATOMIC_LOAD(ptr) __sync_fetch_and_add(ptr, 0)
+    #define ATOMIC_STORE(ptr, val) __sync_bool_compare_and_swap(ptr, *ptr, val)
+    #define ATOMIC_ADD(ptr, val) __sync_fetch_and_add(ptr, val)
+    #define ATOMIC_LOAD_RLX(ptr) (*(ptr))
+    #define ATOMIC_LOAD_ACQ(ptr) __sync_fetch_and_add(ptr, 0)
+    #define ATOMIC_STORE_RLX(ptr, val) (*(ptr) = (val))
+    #define ATOMIC_STORE_REL(ptr, val) do { __sync_synchronize(); *(ptr) = (val); } while (0)
+    #define ATOMIC_CAS(ptr, expected, desired) atomic_cas_int(ptr, expected, desired)
+    #define ATOMIC_CAS_LL(ptr, expected, desired) atomic_cas_llong(ptr, expected, desired)
+    #define ATOMIC_FENCE_ACQ() __sync_synchronize()
+    #define ATOMIC_FENCE_REL() __sync_synchronize()
+    static inline int atomic_cas_int(volatile int *ptr, int *expected, int desired) {
+        int old = __sync_val_compare_and_swap(ptr, *expected, desired);
+        if (old == *expected) {
+            return 1;
+        }
+        *expected = old;
+        return 0;
+    }
+    static inline int atomic_cas_llong(volatile long long *ptr, long long *expected, long long desired) {
+        long long old = __sync_val_compare_and_swap(ptr, *expected, desired);
+        if (old == *expected) {
+            return 1;
+        }
+        *expected = old;
+        return 0;
+    }
+#endif
+
+#endif
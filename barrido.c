@@ -0,0 +1,361 @@
+/**
+ * @file barrido.c
+ * @brief Definiciones del barrido paralelo de parámetros.
+ *
+ * @date 16 de octubre de 2026 (creación)
+ * @version 1.0
+ * @authors
+ * Julio López
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <pthread.h>
+#include "barrido.h"
+#include "simulacion.h"
+
+#define SWEEP_MAX_VALUES    32
+#define COMPARE_VEHICLES    200000  // Mínimo de vehículos por corrida al comparar políticas
+#define COMPARE_SPEC        "llegada_izq=1,4,7,12;llegada_der=1,5,12;politica=todas;modo=lotes,tuberia"
+
+/**
+ * @brief Un eje del barrido: una clave y sus valores.
+ */
+typedef struct {
+    const char *name;                       /**< Clave en la especificación */
+    long long values[SWEEP_MAX_VALUES];     /**< Valores a recorrer */
+    int count;                              /**< Cantidad de valores */
+} SweepAxis;
+
+enum {
+    AXIS_FOCUS, AXIS_OTHER, AXIS_DIVISOR, AXIS_MAX_WINDOW, AXIS_PARKING, AXIS_QUEUE, AXIS_SPEED,
+    AXIS_ARRIVAL_LEFT, AXIS_ARRIVAL_RIGHT, AXIS_POLICY, AXIS_MODE, AXIS_DISTRIBUTION, AXIS_SEED, AXIS_GATES,
+    AXIS_VEHICLES, AXIS_COUNT
+};
+
+/**
+ * @brief Una combinación y su resultado. Cada una ocupa sus propias líneas de caché.
+ */
+typedef struct {
+    SimParams p;                /**< Parámetros de la corrida */
+    long long crossed;          /**< Vehículos que cruzaron */
+    long long simulated;        /**< Tiempo virtual total (us) */
+    long long rejected[3];      /**< Llegadas rechazadas por lado */
+    long long p99Wait[3];       /**< Percentil 99 de la espera por lado (us) */
+    long long maxWait[3];       /**< Espera máxima por lado (us) */
+    double meanWait[3];         /**< Espera promedio por lado (us) */
+    long long flips;            /**< Cambios de dirección */
+    int failed;                 /**< 1 si la simulación no pudo inicializarse */
+} __attribute__((aligned(CACHE_LINE_SIZE))) SweepJob;
+
+typedef struct {
+    SweepJob *jobs;
+    int count;
+    ATOMIC_INT next;            /**< Próxima combinación sin tomar */
+} SweepShared;
+
+/**************************************
+ *      *ESPECIFICACION
+ *************************************/
+
+static void initAxes(SweepAxis axes[AXIS_COUNT], const SimParams *base) {
+    static const char *names[AXIS_COUNT] = {
+        "peso", "peso_contrario", "divisor", "ventana_max", "puente", "cola", "velocidad",
+        "llegada_izq", "llegada_der", "politica", "modo", "distribucion", "semilla", "puertas", "vehiculos"
+    };
+    long long defaults[AXIS_COUNT] = {
+        base->weights.focusWeight, base->weights.otherWeight, base->weights.divisor,
+        0,                                  // 0: el puente por lotes, la cola en tubería
+        base->parkingSize, base->bufferSize, base->parkingSpeed,
+        base->arrivalSpread[1] / base->parkingSpeed, base->arrivalSpread[2] / base->parkingSpeed,
+        base->policy, base->pipelined, base->arrival, (long long)base->seed, base->gates, base->maxVehicles
+    };
+    for (int i = 0; i < AXIS_COUNT; i++) {
+        axes[i].name = names[i];
+        axes[i].values[0] = defaults[i];
+        axes[i].count = 1;
+    }
+}
+
+static const char *modeNames[2] = {"lotes", "tuberia"};
+
+static int findMode(const char *name) {
+    for (int i = 0; i < 2; i++) {
+        if (strcmp(name, modeNames[i]) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+// Lee una lista "v1,v2,..." de enteros positivos sobre el eje. Los ejes de política, modo y distribución
+// reciben nombres.
+static int parseValues(SweepAxis *axis, int axisIndex, char *list) {
+    int isPolicy = (axisIndex == AXIS_POLICY);
+    char *save = NULL;
+    axis->count = 0;
+    for (char *tok = strtok_r(list, ",", &save); tok != NULL; tok = strtok_r(NULL, ",", &save)) {
+        if (isPolicy && strcmp(tok, "todas") == 0) {
+            for (int i = 0; i < POLICY_COUNT && axis->count < SWEEP_MAX_VALUES; i++) {
+                axis->values[axis->count++] = i;
+            }
+            continue;
+        }
+        long long value;
+        int valid;
+        if (isPolicy) {
+            value = findPolicy(tok);
+            valid = (value >= 0);
+        } else if (axisIndex == AXIS_MODE) {
+            value = findMode(tok);
+            valid = (value >= 0);
+        } else if (axisIndex == AXIS_DISTRIBUTION) {
+            value = findArrival(tok);
+            valid = (value >= 0);
+        } else {
+            char *end;
+            value = strtoll(tok, &end, 10);
+            valid = (end != tok && *end == '\0' && value > 0);
+            if ((axisIndex == AXIS_PARKING || axisIndex == AXIS_QUEUE) && value > INT_RING_CAPACITY) {
+                valid = 0;      // Más espacios de los que tiene un CircularBuffer.
+            }
+        }
+        if (!valid || axis->count == SWEEP_MAX_VALUES) {
+            fprintf(stderr, "barrido: valor inválido para %s: '%s'\n", axis->name, tok);
+            return -1;
+        }
+        axis->values[axis->count++] = value;
+    }
+    if (axis->count == 0) {
+        fprintf(stderr, "barrido: %s sin valores\n", axis->name);
+        return -1;
+    }
+    return 0;
+}
+
+static int parseSpec(SweepAxis axes[AXIS_COUNT], const char *spec) {
+    char *copy = strdup(spec);
+    if (copy == NULL) {
+        return -1;
+    }
+    int status = 0;
+    char *save = NULL;
+    for (char *item = strtok_r(copy, ";", &save); item != NULL && status == 0; item = strtok_r(NULL, ";", &save)) {
+        char *eq = strchr(item, '=');
+        if (eq == NULL) {
+            fprintf(stderr, "barrido: se esperaba clave=valores en '%s'\n", item);
+            status = -1;
+            break;
+        }
+        *eq = '\0';
+        int found = -1;
+        for (int i = 0; i < AXIS_COUNT; i++) {
+            if (strcmp(item, axes[i].name) == 0) {
+                found = i;
+            }
+        }
+        if (found < 0) {
+            fprintf(stderr, "barrido: clave desconocida '%s'\n", item);
+            status = -1;
+            break;
+        }
+        status = parseValues(&axes[found], found, eq + 1);
+    }
+    free(copy);
+    return status;
+}
+
+// Parámetros de la combinación "index", recorriendo los ejes como un número en base mixta.
+static void buildParams(const SweepAxis axes[AXIS_COUNT], const SimParams *base, int index, SimParams *p) {
+    long long v[AXIS_COUNT];
+    for (int i = AXIS_COUNT - 1; i >= 0; i--) {
+        v[i] = axes[i].values[index % axes[i].count];
+        index /= axes[i].count;
+    }
+    *p = *base;
+    p->verbose = 0;
+    p->weights.focusWeight = (int)v[AXIS_FOCUS];
+    p->weights.otherWeight = (int)v[AXIS_OTHER];
+    p->weights.divisor = (int)v[AXIS_DIVISOR];
+    p->parkingSize = (int)v[AXIS_PARKING];
+    p->bufferSize = (int)v[AXIS_QUEUE];
+    p->pipelined = (int)v[AXIS_MODE];
+    if (v[AXIS_MAX_WINDOW] > 0) {
+        p->weights.maxWindow = (int)v[AXIS_MAX_WINDOW];
+    } else {
+        p->weights.maxWindow = p->pipelined ? p->bufferSize : p->parkingSize;
+    }
+    p->parkingSpeed = (int)v[AXIS_SPEED];
+    p->admitTimeout = p->parkingSpeed / 2;
+    for (int side = 1; side <= 2; side++) {
+        p->arrivalMin[side] = 2 * p->parkingSpeed;
+    }
+    p->arrivalSpread[1] = (int)(v[AXIS_ARRIVAL_LEFT] * p->parkingSpeed);
+    p->arrivalSpread[2] = (int)(v[AXIS_ARRIVAL_RIGHT] * p->parkingSpeed);
+    p->policy = (PolicyKind)v[AXIS_POLICY];
+    p->arrival = (ArrivalKind)v[AXIS_DISTRIBUTION];
+    p->seed = (unsigned long long)v[AXIS_SEED];
+    p->gates = (int)v[AXIS_GATES];
+    p->maxVehicles = v[AXIS_VEHICLES];
+}
+
+/**************************************
+ *      *EJECUCION
+ *************************************/
+
+static void runJob(SweepJob *job) {
+    Simulacion *sim = malloc(sizeof(Simulacion));
+    if (sim == NULL || initSimulation(sim, &job->p) != 0) {
+        free(sim);
+        job->failed = 1;
+        return;
+    }
+    runSimulation(sim);
+    job->crossed = sim->contador_out;
+    job->simulated = sim->now;
+    job->flips = sim->flips;
+    for (int side = 1; side <= 2; side++) {
+        const Histogram *wait = &sim->latency[side].wait;
+        job->rejected[side] = sim->rejected[side];
+        job->p99Wait[side] = histPercentile(wait, 99);
+        job->maxWait[side] = wait->max;
+        job->meanWait[side] = (wait->count > 0) ? (double)wait->sum / wait->count : 0;
+    }
+    freeSimulation(sim);
+    free(sim);
+}
+
+static void* sweepWorker(void *arg) {
+    SweepShared *shared = (SweepShared*)arg;
+    int index;
+    while ((index = ATOMIC_ADD(&shared->next, 1)) < shared->count) {
+        runJob(&shared->jobs[index]);
+    }
+    return NULL;
+}
+
+/**************************************
+ *      *RESULTADOS
+ *************************************/
+
+// Índice de Jain sobre la espera promedio de cada lado: 1 es perfectamente justo, 0,5 el peor caso con dos lados.
+static double jainIndex(double a, double b) {
+    double sumSquares = a * a + b * b;
+    if (sumSquares == 0) {
+        return 1.0;
+    }
+    return (a + b) * (a + b) / (2.0 * sumSquares);
+}
+
+// Vehículos por segundo ofrecidos por un lado: todas las distribuciones tienen la espera promedio de la
+// uniforme en [min, min + spread).
+static double offeredRate(const SimParams *p, int side) {
+    return 1e6 / (p->arrivalMin[side] + (p->arrivalSpread[side] - 1) / 2.0);
+}
+
+static void printCsv(FILE *out, const SweepJob *jobs, int count) {
+    fprintf(out, "politica,modo,distribucion,semilla,puertas,peso,peso_contrario,divisor,ventana_max,puente,cola,velocidad_us,"
+                 "tasa_izq,tasa_der,vehiculos,tiempo_s,throughput,rechazados_izq,rechazados_der,"
+                 "p99_espera_izq_s,p99_espera_der_s,max_espera_izq_s,max_espera_der_s,jain,cambios\n");
+    for (int i = 0; i < count; i++) {
+        const SweepJob *job = &jobs[i];
+        const SimParams *p = &job->p;
+        if (job->failed) {
+            fprintf(stderr, "barrido: la combinación %d no pudo inicializarse\n", i);
+            continue;
+        }
+        double seconds = job->simulated / 1e6;
+        fprintf(out, "%s,%s,%s,%llu,%d,%d,%d,%d,%d,%d,%d,%d,%.4f,%.4f,%lld,%.3f,%.4f,%lld,%lld,%.3f,%.3f,%.3f,%.3f,%.4f,%lld\n",
+                policyName(p->policy), modeNames[p->pipelined ? 1 : 0], arrivalName(p->arrival), p->seed, p->gates,
+                p->weights.focusWeight, p->weights.otherWeight, p->weights.divisor,
+                p->weights.maxWindow,
+                p->parkingSize, p->bufferSize, p->parkingSpeed,
+                offeredRate(p, 1), offeredRate(p, 2), job->crossed, seconds,
+                (seconds > 0) ? job->crossed / seconds : 0.0, job->rejected[1], job->rejected[2],
+                job->p99Wait[1] / 1e6, job->p99Wait[2] / 1e6, job->maxWait[1] / 1e6, job->maxWait[2] / 1e6,
+                jainIndex(job->meanWait[1], job->meanWait[2]), job->flips);
+    }
+    fflush(out);
+}
+
+int runSweep(const SimParams *base, const char *spec, int threads, FILE *out) {
+    SweepAxis axes[AXIS_COUNT];
+    initAxes(axes, base);
+    if (parseSpec(axes, spec) != 0) {
+        return -1;
+    }
+
+    int count = 1;
+    for (int i = 0; i < AXIS_COUNT; i++) {
+        count *= axes[i].count;
+    }
+
+    SweepShared shared;
+    if (posix_memalign((void**)&shared.jobs, CACHE_LINE_SIZE, count * sizeof(SweepJob)) != 0) {
+        return -1;
+    }
+    memset(shared.jobs, 0, count * sizeof(SweepJob));
+    for (int i = 0; i < count; i++) {
+        buildParams(axes, base, i, &shared.jobs[i].p);
+    }
+    shared.count = count;
+    ATOMIC_STORE(&shared.next, 0);
+
+    if (threads <= 0) {
+        threads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    }
+    if (threads > count) {
+        threads = count;
+    }
+    if (threads < 1) {
+        threads = 1;
+    }
+
+    pthread_t *workers = malloc(threads * sizeof(pthread_t));
+    if (workers == NULL) {
+        free(shared.jobs);
+        return -1;
+    }
+    int started = 0;
+    for (int i = 0; i < threads; i++) {
+        if (pthread_create(&workers[started], NULL, sweepWorker, &shared) == 0) {
+            started++;
+        }
+    }
+    if (started == 0) {
+        sweepWorker(&shared);   // Sin hilos disponibles, se corre todo en el actual.
+    }
+    for (int i = 0; i < started; i++) {
+        pthread_join(workers[i], NULL);
+    }
+
+    printCsv(out, shared.jobs, count);
+    free(workers);
+    free(shared.jobs);
+    return 0;
+}
+
+int parseParams(const SimParams *base, const char *spec, SimParams *out) {
+    SweepAxis axes[AXIS_COUNT];
+    initAxes(axes, base);
+    if (parseSpec(axes, spec) != 0) {
+        return -1;
+    }
+    for (int i = 0; i < AXIS_COUNT; i++) {
+        if (axes[i].count != 1) {
+            fprintf(stderr, "barrido: %s debe tener un solo valor\n", axes[i].name);
+            return -1;
+        }
+    }
+    buildParams(axes, base, 0, out);
+    return 0;
+}
+
+int runPolicyComparison(const SimParams *base, int threads, FILE *out) {
+    SimParams params = *base;
+    if (params.maxVehicles < COMPARE_VEHICLES) {
+        params.maxVehicles = COMPARE_VEHICLES;
+    }
+    return runSweep(&params, COMPARE_SPEC, threads, out);
+}
@@ -0,0 +1,76 @@
+/**
+ * @file barrido.h
+ * @brief Barrido paralelo de parámetros sobre la simulación de eventos discretos.
+ *
+ * @details
+ * Cada combinación de parámetros es una instancia independiente de Simulacion (colas, reloj, generador y
+ * estadísticas propias), así que las combinaciones se reparten entre hilos sin compartir estado: cada hilo toma
+ * la siguiente combinación con un contador atómico y escribe su resultado en un espacio propio alineado a la
+ * línea de caché. Al final se imprime una fila CSV por combinación, en el orden de la especificación.
+ *
+ * La especificación es una lista de "clave=v1,v2,..." separadas por ';'. Claves reconocidas:
+ *  - peso, peso_contrario, divisor, ventana_max: pesos de computeWindowSize() (ventana_max por defecto es el
+ *    puente por lotes y la cola en tubería)
+ *  - puente: espacios del puente
+ *  - cola: capacidad de cada cola de espera
+ *  - velocidad: PARKING_SPEED en microsegundos
+ *  - llegada_izq, llegada_der: dispersión de las llegadas, en múltiplos de la velocidad
+ *  - politica: nombres de políticas (ver politicas.h), o "todas"
+ *  - modo: lotes (el puente se llena y luego se vacía) o tuberia (entran y salen en el mismo paso)
+ *  - distribucion: espera entre llegadas, uniforme, exponencial o rafagas (ver aleatorio.h)
+ *  - semilla: semillas de las llegadas, para repetir una misma combinación con llegadas distintas
+ *  - puertas: fuentes de llegada por lado, que se reparten la tasa del lado
+ *  - vehiculos: la corrida termina cuando cruzan más de esta cantidad
+ *
+ * @date 16 de octubre de 2026 (creación)
+ * @version 1.0
+ * @authors
+ * Julio López
+ */
+
+#ifndef BARRIDO_H
+#define BARRIDO_H
+
+#include <stdio.h>
+#include "funciones.h"
+
+
+/**
+ * @brief Corre todas las combinaciones de la especificación y escribe los resultados en CSV.
+ *
+ * @param base Parámetros de partida; las claves ausentes de la especificación toman su valor de aquí
+ * @param spec Especificación del barrido
+ * @param threads Hilos a usar (0 o menos: uno por procesador)
+ * @param out Archivo de salida del CSV
+ * @return 0 si todo salió bien, -1 si la especificación es inválida o no hubo memoria
+ */
+int runSweep(const SimParams *base, const char *spec, int threads, FILE *out);
+
+
+/**
+ * @brief Arma los parámetros de una sola corrida a partir de una especificación con un valor por clave.
+ *
+ * @param base Parámetros de partida; las claves ausentes toman su valor de aquí
+ * @param spec Especificación, con la misma sintaxis que runSweep()
+ * @param out Parámetros resultantes
+ * @return 0 si todo salió bien, -1 si la especificación es inválida o alguna clave tiene varios valores
+ */
+int parseParams(const SimParams *base, const char *spec, SimParams *out);
+
+
+/**
+ * @brief Compara todas las políticas, en los dos modos del puente, con varias combinaciones de tasas de
+ * llegada por lado.
+ *
+ * Es un barrido fijo con al menos COMPARE_VEHICLES vehículos por corrida, para que las filas de una misma
+ * carga queden juntas y se puedan comparar directamente.
+ *
+ * @param base Parámetros de partida
+ * @param threads Hilos a usar (0 o menos: uno por procesador)
+ * @param out Archivo de salida del CSV
+ * @return 0 si todo salió bien, -1 si no hubo memoria
+ */
+int runPolicyComparison(const SimParams *base, int threads, FILE *out);
+
+
+#endif
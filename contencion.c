@@ -0,0 +1,226 @@
+/**
+ * @file contencion.c
+ * @brief Definiciones del perfil de contención de bloqueos.
+ *
+ * @date 16 de octubre de 2026 (creación)
+ * @version 1.0
+ * @authors
+ * Julio López
+ */
+
+#include <stdlib.h>
+#include <time.h>
+#include "contencion.h"
+
+static const void *lockAddress[CONTENTION_MAX_LOCKS];
+static char lockName[CONTENTION_MAX_LOCKS][CONTENTION_NAME_SIZE];
+static int lockCount = 0;
+
+// Lista de búferes; solo se toca al registrar un hilo y en el reporte.
+static ThreadContention *threads = NULL;
+static int threadCount = 0;
+static pthread_mutex_t threadsMutex = PTHREAD_MUTEX_INITIALIZER;
+
+static __thread ThreadContention *self = NULL;
+
+static long long monotonicNs() {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec * 1000000000LL + now.tv_nsec;
+}
+
+// Índice del bloqueo registrado; los bloqueos son pocos y la tabla no cambia mientras corren los hilos.
+static int findLock(const void *lock) {
+    for (int i = 0; i < lockCount; i++) {
+        if (lockAddress[i] == lock) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+static ThreadContention *currentThread() {
+    if (self == NULL) {
+        ThreadContention *t = calloc(1, sizeof(ThreadContention));
+        for (int i = 0; i < CONTENTION_MAX_LOCKS; i++) {
+            histInit(&t->locks[i].wait);
+            histInit(&t->locks[i].hold);
+        }
+        pthread_mutex_lock(&threadsMutex);
+        snprintf(t->name, sizeof(t->name), "hilo %d", ++threadCount);
+        t->next = threads;
+        threads = t;
+        pthread_mutex_unlock(&threadsMutex);
+        self = t;
+    }
+    return self;
+}
+
+void contentionRegister(const void *lock, const char *name) {
+    if (lockCount >= CONTENTION_MAX_LOCKS || findLock(lock) >= 0) {
+        return;
+    }
+    lockAddress[lockCount] = lock;
+    snprintf(lockName[lockCount], CONTENTION_NAME_SIZE, "%s", name);
+    lockCount++;
+}
+
+void contentionThread(const char *name) {
+    ThreadContention *t = currentThread();
+    snprintf(t->name, sizeof(t->name), "%s", name);
+}
+
+// Anota una adquisición: "requested" es el instante en que se pidió, o 0 si se obtuvo sin esperar.
+static void acquired(int id, long long requested) {
+    LockStats *s = &currentThread()->locks[id];
+    long long now = monotonicNs();
+    s->acquired++;
+    if (requested > 0) {
+        s->contended++;
+        histRecord(&s->wait, now - requested);
+    } else {
+        histRecord(&s->wait, 0);
+    }
+    s->heldSince = now;
+}
+
+static void released(int id) {
+    LockStats *s = &currentThread()->locks[id];
+    histRecord(&s->hold, monotonicNs() - s->heldSince);
+}
+
+int contentionSemWait(sem_t *sem) {
+    int id = findLock(sem);
+    if (id < 0) {
+        return sem_wait(sem);
+    }
+    if (sem_trywait(sem) == 0) {
+        acquired(id, 0);
+        return 0;
+    }
+    long long requested = monotonicNs();
+    int rc = sem_wait(sem);
+    if (rc == 0) {
+        acquired(id, requested);
+    }
+    return rc;
+}
+
+int contentionSemPost(sem_t *sem) {
+    int id = findLock(sem);
+    if (id >= 0) {
+        released(id);
+    }
+    return sem_post(sem);
+}
+
+int contentionMutexLock(pthread_mutex_t *mutex) {
+    int id = findLock(mutex);
+    if (id < 0) {
+        return pthread_mutex_lock(mutex);
+    }
+    if (pthread_mutex_trylock(mutex) == 0) {
+        acquired(id, 0);
+        return 0;
+    }
+    long long requested = monotonicNs();
+    int rc = pthread_mutex_lock(mutex);
+    if (rc == 0) {
+        acquired(id, requested);
+    }
+    return rc;
+}
+
+int contentionMutexUnlock(pthread_mutex_t *mutex) {
+    int id = findLock(mutex);
+    if (id >= 0) {
+        released(id);
+    }
+    return pthread_mutex_unlock(mutex);
+}
+
+static void printRow(FILE *out, const char *lock, const char *thread, const LockStats *s, long long elapsedUs) {
+    double waitMs = s->wait.sum / 1e6;
+    fprintf(out, "%-18s %-12s %10lld %10lld %12.3f %6.2f%% %10.2f %10.2f %10.2f %12.3f %10.2f %10.2f %10.2f\n",
+            lock, thread, s->acquired, s->contended, waitMs,
+            (elapsedUs > 0) ? waitMs * 1e5 / elapsedUs : 0.0,
+            histPercentile(&s->wait, 50) / 1e3, histPercentile(&s->wait, 99) / 1e3, s->wait.max / 1e3,
+            s->hold.sum / 1e6, histPercentile(&s->hold, 50) / 1e3, histPercentile(&s->hold, 99) / 1e3,
+            s->hold.max / 1e3);
+}
+
+static void mergeStats(LockStats *dst, const LockStats *src) {
+    dst->acquired += src->acquired;
+    dst->contended += src->contended;
+    histMerge(&dst->wait, &src->wait);
+    histMerge(&dst->hold, &src->hold);
+}
+
+void printContentionReport(FILE *out, long long elapsedUs) {
+    if (lockCount == 0) {
+        return;
+    }
+    pthread_mutex_lock(&threadsMutex);
+    int order[CONTENTION_MAX_LOCKS];
+    LockStats *total = calloc(lockCount, sizeof(LockStats));
+    for (int i = 0; i < lockCount; i++) {
+        order[i] = i;
+        histInit(&total[i].wait);
+        histInit(&total[i].hold);
+        for (ThreadContention *t = threads; t != NULL; t = t->next) {
+            mergeStats(&total[i], &t->locks[i]);
+        }
+    }
+    // Pocos bloqueos: inserción por tiempo total de espera, de mayor a menor.
+    for (int i = 1; i < lockCount; i++) {
+        int id = order[i];
+        int j = i;
+        while (j > 0 && total[order[j - 1]].wait.sum < total[id].wait.sum) {
+            order[j] = order[j - 1];
+            j--;
+        }
+        order[j] = id;
+    }
+
+    fprintf(out, "\nContención de bloqueos (%d hilos, %.3f s; tiempos de espera y retención en us salvo los "
+            "totales en ms)\n", threadCount, elapsedUs / 1e6);
+    fprintf(out, "%-18s %-12s %10s %10s %12s %7s %10s %10s %10s %12s %10s %10s %10s\n", "Bloqueo", "Hilo",
+            "Tomas", "Esperaron", "Espera_ms", "%Real", "Esp_p50", "Esp_p99", "Esp_max", "Retencion_ms",
+            "Ret_p50", "Ret_p99", "Ret_max");
+    ThreadContention **byWait = malloc((threadCount > 0 ? threadCount : 1) * sizeof(ThreadContention*));
+    for (int k = 0; k < lockCount; k++) {
+        int id = order[k];
+        printRow(out, lockName[id], "(todos)", &total[id], elapsedUs);
+        // Debajo, los hilos que tomaron el bloqueo, también de mayor a menor espera.
+        int n = 0;
+        for (ThreadContention *t = threads; t != NULL; t = t->next) {
+            if (t->locks[id].acquired == 0) {
+                continue;
+            }
+            int j = n++;
+            while (j > 0 && byWait[j - 1]->locks[id].wait.sum < t->locks[id].wait.sum) {
+                byWait[j] = byWait[j - 1];
+                j--;
+            }
+            byWait[j] = t;
+        }
+        for (int j = 0; j < n; j++) {
+            printRow(out, "", byWait[j]->name, &byWait[j]->locks[id], elapsedUs);
+        }
+    }
+    free(byWait);
+    free(total);
+    pthread_mutex_unlock(&threadsMutex);
+}
+
+void freeContention() {
+    pthread_mutex_lock(&threadsMutex);
+    while (threads != NULL) {
+        ThreadContention *next = threads->next;
+        free(threads);
+        threads = next;
+    }
+    threadCount = 0;
+    lockCount = 0;
+    pthread_mutex_unlock(&threadsMutex);
+}
@@ -0,0 +1,129 @@
+/**
+ * @file contencion.h
+ * @brief Perfil de contención de los semáforos y el mutex del camino caliente.
+ *
+ * @details
+ * Al compilar con make PROFILE=locks, las tomas y liberaciones de leftSemaphore, rightSemaphore,
+ * parkingSemaphore y printMutex pasan por estas funciones, que cuentan las adquisiciones (y cuántas tuvieron
+ * que esperar) y registran en histogramas el tiempo hasta adquirir y el tiempo que se retuvo cada bloqueo,
+ * por bloqueo y por hilo. Al terminar la corrida con hilos se imprime un reporte ordenado por tiempo total
+ * de espera.
+ *
+ * Cada hilo escribe solo en su propio búfer (una variable por hilo), así que medir no agrega contención: la
+ * única sección compartida es el registro del hilo en su primera toma. Si el bloqueo está libre, se toma con
+ * sem_trywait()/pthread_mutex_trylock() y cuesta una lectura del reloj; si hay que esperar, dos.
+ * CLOCK_MONOTONIC se lee por vDSO, sin syscall. Sin PROFILE=locks las macros son las llamadas de siempre.
+ *
+ * @date 16 de octubre de 2026 (creación)
+ * @version 1.0
+ * @authors
+ * Julio López
+ */
+
+#ifndef CONTENCION_H
+#define CONTENCION_H
+
+#include <stdio.h>
+#include <pthread.h>
+#include <semaphore.h>
+#include "estadisticas.h"
+
+#define CONTENTION_MAX_LOCKS    8       // Bloqueos registrados como máximo
+#define CONTENTION_NAME_SIZE    24
+
+/**
+ * @brief Mediciones de un bloqueo en un hilo. Los tiempos se registran en nanosegundos.
+ */
+typedef struct {
+    long long acquired;         /**< Adquisiciones */
+    long long contended;        /**< Adquisiciones que encontraron el bloqueo tomado */
+    long long heldSince;        /**< Instante de la última adquisición (ns) */
+    Histogram wait;             /**< Desde que se pide hasta que se obtiene */
+    Histogram hold;             /**< Desde que se obtiene hasta que se libera */
+} LockStats;
+
+/**
+ * @brief Búfer de un hilo. Solo lo escribe ese hilo; el reporte lo lee después de unir los hilos.
+ */
+typedef struct ThreadContention {
+    char name[CONTENTION_NAME_SIZE];        /**< Nombre dado con contentionThread() o "hilo N" */
+    LockStats locks[CONTENTION_MAX_LOCKS];  /**< Mediciones por bloqueo registrado */
+    struct ThreadContention *next;          /**< Siguiente hilo registrado */
+} ThreadContention;
+
+
+/**
+ * @brief Registra un bloqueo con su nombre. Se llama antes de crear los hilos; las tomas de bloqueos no
+ * registrados pasan sin medirse.
+ *
+ * @param lock Dirección del sem_t o pthread_mutex_t
+ * @param name Nombre en el reporte
+ */
+void contentionRegister(const void *lock, const char *name);
+
+
+/**
+ * @brief Nombra al hilo que llama en el reporte.
+ *
+ * @param name Nombre
+ */
+void contentionThread(const char *name);
+
+
+/**
+ * @brief sem_wait() medido.
+ */
+int contentionSemWait(sem_t *sem);
+
+
+/**
+ * @brief sem_post() medido.
+ */
+int contentionSemPost(sem_t *sem);
+
+
+/**
+ * @brief pthread_mutex_lock() medido.
+ */
+int contentionMutexLock(pthread_mutex_t *mutex);
+
+
+/**
+ * @brief pthread_mutex_unlock() medido.
+ */
+int contentionMutexUnlock(pthread_mutex_t *mutex);
+
+
+/**
+ * @brief Imprime el reporte: un total por bloqueo, de mayor a menor tiempo total de espera, y debajo el
+ * detalle por hilo en el mismo orden.
+ *
+ * @param out Destino
+ * @param elapsedUs Duración de la corrida, para expresar la espera como fracción del tiempo real
+ */
+void printContentionReport(FILE *out, long long elapsedUs);
+
+
+/**
+ * @brief Libera los búferes de los hilos y olvida los bloqueos registrados.
+ */
+void freeContention();
+
+
+/* Con make PROFILE=locks los bloqueos del camino caliente se miden */
+#ifdef LOCK_PROFILE
+    #define PROFILED_SEM_WAIT(sem)          contentionSemWait(sem)
+    #define PROFILED_SEM_POST(sem)          contentionSemPost(sem)
+    #define PROFILED_MUTEX_LOCK(mutex)      contentionMutexLock(mutex)
+    #define PROFILED_MUTEX_UNLOCK(mutex)    contentionMutexUnlock(mutex)
+    #define PROFILED_THREAD(name)           contentionThread(name)
+#else
+    #define PROFILED_SEM_WAIT(sem)          sem_wait(sem)
+    #define PROFILED_SEM_POST(sem)          sem_post(sem)
+    #define PROFILED_MUTEX_LOCK(mutex)      pthread_mutex_lock(mutex)
+    #define PROFILED_MUTEX_UNLOCK(mutex)    pthread_mutex_unlock(mutex)
+    #define PROFILED_THREAD(name)           ((void)(name))
+#endif
+
+
+#endif
@@ -0,0 +1,95 @@
+/**
+ * @file control.c
+ * @brief Definiciones del hilo de control de la corrida.
+ *
+ * @date 16 de octubre de 2026 (creación)
+ * @version 1.0
+ * @authors
+ * Julio López
+ */
+
+#include <limits.h>
+#include <time.h>
+#include "control.h"
+
+static long long monotonicUs() {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec * 1000000LL + now.tv_nsec / 1000;
+}
+
+static void stopSignals(sigset_t *set) {
+    sigemptyset(set);
+    sigaddset(set, SIGINT);
+    sigaddset(set, SIGTERM);
+}
+
+static void* controlThread(void *arg) {
+    RunControl *rc = (RunControl*)arg;
+    sigset_t set;
+    stopSignals(&set);
+    long long deadline = (rc->wallLimitUs > 0) ? monotonicUs() + rc->wallLimitUs : LLONG_MAX;
+
+    while (!ATOMIC_LOAD(&rc->finished)) {
+        long long left = deadline - monotonicUs();
+        if (left <= 0) {
+            ATOMIC_STORE(&rc->reason, STOP_WALL_LIMIT);
+            rc->onStop(rc->ctx, STOP_WALL_LIMIT);
+            break;
+        }
+        struct timespec timeout;
+        timeout.tv_sec = left / 1000000;
+        timeout.tv_nsec = (left % 1000000) * 1000;
+        int sig = sigtimedwait(&set, NULL, &timeout);
+        if (sig == SIGINT || sig == SIGTERM) {
+            // finishRunControl() también despierta al hilo con SIGTERM, pero antes marca finished.
+            if (!ATOMIC_LOAD(&rc->finished)) {
+                ATOMIC_STORE(&rc->reason, STOP_SIGNAL);
+                rc->onStop(rc->ctx, STOP_SIGNAL);
+            }
+            break;
+        }
+        // EAGAIN: se recalcula el plazo arriba. EINTR: otra señal (SIGUSR1), se sigue esperando.
+    }
+    return NULL;
+}
+
+int startRunControl(RunControl *rc, long long wallLimitUs, void (*onStop)(void *ctx, StopReason why), void *ctx) {
+    sigset_t set;
+    stopSignals(&set);
+    rc->wallLimitUs = wallLimitUs;
+    rc->onStop = onStop;
+    rc->ctx = ctx;
+    ATOMIC_STORE(&rc->reason, STOP_NONE);
+    ATOMIC_STORE(&rc->finished, 0);
+    pthread_sigmask(SIG_BLOCK, &set, &rc->oldMask);
+    if (pthread_create(&rc->thread, NULL, controlThread, rc) != 0) {
+        pthread_sigmask(SIG_SETMASK, &rc->oldMask, NULL);
+        return -1;
+    }
+    return 0;
+}
+
+StopReason finishRunControl(RunControl *rc) {
+    ATOMIC_STORE(&rc->finished, 1);
+    // Dirigida al hilo: si ya terminó, la señal no queda pendiente para el proceso.
+    pthread_kill(rc->thread, SIGTERM);
+    pthread_join(rc->thread, NULL);
+    sigset_t set;
+    struct timespec zero = {0, 0};
+    stopSignals(&set);
+    while (sigtimedwait(&set, NULL, &zero) > 0) {
+        // Llegó después de la primera (timeout y la terminal avisan a todo el grupo de procesos) y ya no hay
+        // corrida que detener: se descarta antes de desbloquearla, si no mataría al proceso en el reporte.
+    }
+    pthread_sigmask(SIG_SETMASK, &rc->oldMask, NULL);
+    return (StopReason)ATOMIC_LOAD(&rc->reason);
+}
+
+const char* stopReasonName(StopReason why) {
+    switch (why) {
+    case STOP_SIGNAL:       return "cancelada por señal";
+    case STOP_WALL_LIMIT:   return "límite de tiempo real";
+    default:                return "";
+    }
+}
@@ -0,0 +1,79 @@
+/**
+ * @file control.h
+ * @brief Cancelación de la corrida por señal o por límite de tiempo real.
+ *
+ * @details
+ * startRunControl() bloquea SIGINT y SIGTERM en el hilo que llama (los hilos que se crean después heredan la
+ * máscara) y lanza un hilo que las espera con sigtimedwait(), con el límite de tiempo real como plazo. Si llega
+ * una de las dos o vence el plazo, el hilo llama una sola vez a onStop, que es quien despierta a los demás: con
+ * hilos, requestStop() de main.c avisa a los que duermen; en la simulación de eventos se marca la simulación
+ * para que se detenga entre dos eventos. Así el Ctrl-C termina la corrida de forma ordenada, con reporte final,
+ * pantalla restaurada y punto de control, en vez de matar el proceso.
+ *
+ * @date 16 de octubre de 2026 (creación)
+ * @version 1.0
+ * @authors
+ * Julio López
+ */
+
+#ifndef CONTROL_H
+#define CONTROL_H
+
+#include <pthread.h>
+#include <signal.h>
+#include "funciones.h"
+
+/**
+ * @brief Motivo por el que terminó la corrida antes de tiempo.
+ */
+typedef enum {
+    STOP_NONE,          /**< No se pidió detenerla */
+    STOP_SIGNAL,        /**< Llegó SIGINT o SIGTERM */
+    STOP_WALL_LIMIT     /**< Venció el límite de tiempo real */
+} StopReason;
+
+/**
+ * @brief Hilo de control de una corrida.
+ */
+typedef struct {
+    pthread_t thread;                           /**< Hilo que espera las señales */
+    long long wallLimitUs;                      /**< Límite de tiempo real en us, 0 si no hay */
+    void (*onStop)(void *ctx, StopReason why);  /**< Se llama una vez, desde el hilo de control */
+    void *ctx;                                  /**< Se pasa tal cual a onStop */
+    ATOMIC_INT reason;                          /**< StopReason de la corrida */
+    ATOMIC_INT finished;                        /**< 1 cuando la corrida terminó sola */
+    sigset_t oldMask;                           /**< Máscara anterior del hilo que llamó */
+} RunControl;
+
+
+/**
+ * @brief Bloquea SIGINT y SIGTERM y lanza el hilo de control. Se llama antes de crear los demás hilos.
+ *
+ * @param rc Control a inicializar
+ * @param wallLimitUs Límite de tiempo real en microsegundos desde ahora, 0 si no hay
+ * @param onStop Se llama al llegar una señal o vencer el límite
+ * @param ctx Contexto de onStop
+ * @return 0 si todo salió bien, -1 si no se pudo crear el hilo
+ */
+int startRunControl(RunControl *rc, long long wallLimitUs, void (*onStop)(void *ctx, StopReason why), void *ctx);
+
+
+/**
+ * @brief Termina el hilo de control después de que terminó la corrida y restaura la máscara de señales.
+ *
+ * @param rc Control
+ * @return StopReason Por qué terminó la corrida
+ */
+StopReason finishRunControl(RunControl *rc);
+
+
+/**
+ * @brief Texto del motivo, para el reporte final.
+ *
+ * @param why Motivo
+ * @return const char* "", "cancelada por señal" o "límite de tiempo real"
+ */
+const char* stopReasonName(StopReason why);
+
+
+#endif
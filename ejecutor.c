@@ -0,0 +1,191 @@
+/**
+ * @file ejecutor.c
+ * @brief Definiciones del grupo de hilos con robo de trabajo.
+ *
+ * @date 16 de octubre de 2026 (creación)
+ * @version 1.0
+ * @authors
+ * Julio López
+ */
+
+#include <stdlib.h>
+#include <sched.h>
+#include <unistd.h>
+#include "ejecutor.h"
+
+#define NO_TASK     (-1)
+
+/**************************************
+ *      *DEQUE DE TAREAS
+ *************************************/
+
+static int initDeque(WorkDeque *dq, int capacity) {
+    int n = 1;
+    while (n < capacity) {
+        n <<= 1;
+    }
+    dq->tasks = malloc(n * sizeof(ATOMIC_INT));
+    if (dq->tasks == NULL) {
+        return -1;
+    }
+    dq->mask = n - 1;
+    ATOMIC_STORE(&dq->top, 0);
+    ATOMIC_STORE(&dq->bottom, 0);
+    return 0;
+}
+
+// Solo el dueño. La capacidad alcanza para todas las tareas, así que nunca se llena.
+static void pushTask(WorkDeque *dq, int task) {
+    int b = ATOMIC_LOAD_RLX(&dq->bottom);
+    ATOMIC_STORE_RLX(&dq->tasks[b & dq->mask], task);
+    ATOMIC_STORE_REL(&dq->bottom, b + 1);
+}
+
+// Solo el dueño. Compite con los ladrones únicamente por la última tarea.
+static int takeTask(WorkDeque *dq) {
+    int b = ATOMIC_LOAD_RLX(&dq->bottom) - 1;
+    ATOMIC_STORE(&dq->bottom, b);       // Secuencialmente consistente: debe verse antes de leer top.
+    int t = ATOMIC_LOAD(&dq->top);
+    if (t > b) {
+        ATOMIC_STORE_RLX(&dq->bottom, b + 1);
+        return NO_TASK;
+    }
+    int task = ATOMIC_LOAD_RLX(&dq->tasks[b & dq->mask]);
+    if (t == b) {
+        if (!ATOMIC_CAS(&dq->top, &t, t + 1)) {
+            task = NO_TASK;         // Un ladrón se la llevó.
+        }
+        ATOMIC_STORE_RLX(&dq->bottom, b + 1);
+    }
+    return task;
+}
+
+// Cualquier hilo.
+static int stealTask(WorkDeque *dq) {
+    int t = ATOMIC_LOAD(&dq->top);
+    int b = ATOMIC_LOAD(&dq->bottom);
+    if (t >= b) {
+        return NO_TASK;
+    }
+    int task = ATOMIC_LOAD_RLX(&dq->tasks[t & dq->mask]);
+    if (!ATOMIC_CAS(&dq->top, &t, t + 1)) {
+        return NO_TASK;             // Otro ladrón o el dueño ganó.
+    }
+    return task;
+}
+
+/**************************************
+ *      *HILOS
+ *************************************/
+
+static int findTask(Worker *w) {
+    int task = takeTask(&w->deque);
+    if (task != NO_TASK || w->ex->count == 1) {
+        return task;
+    }
+    // Se intenta con cada uno de los otros hilos, empezando por uno al azar.
+    int first = (int)randomBelow(&w->rng, (uint32_t)w->ex->count);
+    for (int i = 0; i < w->ex->count; i++) {
+        Worker *victim = &w->ex->workers[(first + i) % w->ex->count];
+        if (victim == w) {
+            continue;
+        }
+        task = stealTask(&victim->deque);
+        if (task != NO_TASK) {
+            w->steals++;
+            return task;
+        }
+    }
+    return NO_TASK;
+}
+
+static void* workerLoop(void *arg) {
+    Worker *w = (Worker*)arg;
+    Executor *ex = w->ex;
+    while (ATOMIC_LOAD(&ex->remaining) > 0) {
+        int task = findTask(w);
+        if (task == NO_TASK) {
+            sched_yield();      // Lo que queda lo están corriendo otros hilos.
+            continue;
+        }
+        w->slices++;
+        if (ex->fn(task, ex->ctx)) {
+            pushTask(&w->deque, task);
+        } else {
+            ATOMIC_ADD(&ex->remaining, -1);
+        }
+    }
+    return NULL;
+}
+
+int startExecutor(Executor *ex, int tasks, int threads, TaskFn fn, void *ctx) {
+    if (threads <= 0) {
+        threads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    }
+    if (threads < 1) {
+        threads = 1;
+    }
+    ex->fn = fn;
+    ex->ctx = ctx;
+    ex->count = threads;
+    ex->started = 0;
+    ATOMIC_STORE(&ex->remaining, tasks);
+    if (posix_memalign((void**)&ex->workers, CACHE_LINE_SIZE, threads * sizeof(Worker)) != 0) {
+        return -1;
+    }
+    for (int i = 0; i < threads; i++) {
+        Worker *w = &ex->workers[i];
+        w->ex = ex;
+        w->index = i;
+        w->slices = 0;
+        w->steals = 0;
+        seedRng(&w->rng, 1, i);
+        if (initDeque(&w->deque, tasks) != 0) {
+            for (int j = 0; j < i; j++) {
+                free(ex->workers[j].deque.tasks);
+            }
+            free(ex->workers);
+            return -1;
+        }
+    }
+    // Reparto inicial por turnos; el desbalance que quede lo corrige el robo.
+    for (int task = 0; task < tasks; task++) {
+        pushTask(&ex->workers[task % threads].deque, task);
+    }
+    for (int i = 0; i < threads; i++) {
+        if (pthread_create(&ex->workers[i].thread, NULL, workerLoop, &ex->workers[i]) != 0) {
+            break;
+        }
+        ex->started++;
+    }
+    if (ex->started == 0) {
+        joinExecutor(ex, NULL, NULL);
+        return -1;
+    }
+    return 0;
+}
+
+int executorPending(Executor *ex) {
+    return ATOMIC_LOAD(&ex->remaining);
+}
+
+void joinExecutor(Executor *ex, long long *slices, long long *steals) {
+    long long totalSlices = 0;
+    long long totalSteals = 0;
+    for (int i = 0; i < ex->started; i++) {
+        pthread_join(ex->workers[i].thread, NULL);
+    }
+    for (int i = 0; i < ex->count; i++) {
+        totalSlices += ex->workers[i].slices;
+        totalSteals += ex->workers[i].steals;
+        free(ex->workers[i].deque.tasks);
+    }
+    free(ex->workers);
+    ex->workers = NULL;
+    if (slices != NULL) {
+        *slices = totalSlices;
+    }
+    if (steals != NULL) {
+        *steals = totalSteals;
+    }
+}
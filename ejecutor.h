@@ -0,0 +1,106 @@
+/**
+ * @file ejecutor.h
+ * @brief Grupo de hilos con robo de trabajo para correr tareas por tramos.
+ *
+ * @details
+ * Cada hilo tiene su propia deque de tareas (Chase-Lev): el dueño agrega y saca por abajo sin competir con
+ * nadie, y los hilos que se quedan sin trabajo roban por arriba de la deque de otro, elegido al azar. Una
+ * tarea es un índice; la función de la tarea corre un tramo y dice si falta más, y en ese caso la tarea vuelve
+ * a la deque del hilo que la corrió, de donde otro hilo ocioso la puede robar. Así las tareas largas no dejan
+ * hilos sin trabajo mientras quede alguna en espera.
+ *
+ * Cada hilo y cada deque ocupan sus propias líneas de caché.
+ *
+ * @date 16 de octubre de 2026 (creación)
+ * @version 1.0
+ * @authors
+ * Julio López
+ */
+
+#ifndef EJECUTOR_H
+#define EJECUTOR_H
+
+#include <pthread.h>
+#include "funciones.h"
+
+/**
+ * @brief Corre un tramo de la tarea "task".
+ *
+ * @return 1 si la tarea sigue (vuelve a la cola), 0 si terminó
+ */
+typedef int (*TaskFn)(int task, void *ctx);
+
+/**
+ * @brief Deque de tareas de un hilo, con capacidad fija para todas las tareas del ejecutor.
+ */
+typedef struct {
+    ATOMIC_INT top;             /**< Próxima tarea a robar */
+    char pad0[CACHE_LINE_SIZE - sizeof(ATOMIC_INT)];
+    ATOMIC_INT bottom;          /**< Próxima posición libre del dueño */
+    char pad1[CACHE_LINE_SIZE - sizeof(ATOMIC_INT)];
+    ATOMIC_INT *tasks;          /**< Arreglo circular de índices de tarea */
+    int mask;                   /**< Capacidad - 1 */
+} WorkDeque;
+
+struct Executor;
+
+/**
+ * @brief Un hilo del ejecutor.
+ */
+typedef struct {
+    WorkDeque deque;            /**< Tareas propias */
+    struct Executor *ex;        /**< Ejecutor al que pertenece */
+    pthread_t thread;           /**< Hilo */
+    int index;                  /**< Posición en el arreglo de hilos */
+    Rng rng;                    /**< Elige a quién robarle */
+    long long slices;           /**< Tramos corridos */
+    long long steals;           /**< Tareas robadas */
+} __attribute__((aligned(CACHE_LINE_SIZE))) Worker;
+
+/**
+ * @brief Ejecutor con robo de trabajo.
+ */
+typedef struct Executor {
+    ATOMIC_INT remaining;       /**< Tareas sin terminar */
+    char pad[CACHE_LINE_SIZE - sizeof(ATOMIC_INT)];
+    Worker *workers;            /**< Hilos */
+    int count;                  /**< Cantidad de hilos */
+    int started;                /**< Hilos que se pudieron crear */
+    TaskFn fn;                  /**< Función de las tareas */
+    void *ctx;                  /**< Argumento de fn */
+} Executor;
+
+
+/**
+ * @brief Reparte las tareas 0 .. tasks - 1 entre los hilos y los pone a correr.
+ *
+ * @param ex Ejecutor a inicializar
+ * @param tasks Cantidad de tareas
+ * @param threads Hilos a usar (0 o menos: uno por procesador)
+ * @param fn Función de las tareas
+ * @param ctx Se pasa tal cual a fn
+ * @return 0 si todo salió bien, -1 si no hubo memoria o no se pudo crear ningún hilo
+ */
+int startExecutor(Executor *ex, int tasks, int threads, TaskFn fn, void *ctx);
+
+
+/**
+ * @brief Tareas que todavía no terminaron. Se puede consultar desde otro hilo mientras el ejecutor corre.
+ *
+ * @param ex Ejecutor
+ * @return int
+ */
+int executorPending(Executor *ex);
+
+
+/**
+ * @brief Espera a que terminen todas las tareas y libera los hilos.
+ *
+ * @param ex Ejecutor
+ * @param slices Si no es NULL, tramos corridos en total
+ * @param steals Si no es NULL, tareas robadas en total
+ */
+void joinExecutor(Executor *ex, long long *slices, long long *steals);
+
+
+#endif
@@ -0,0 +1,223 @@
+/**
+ * @file estadisticas.c
+ * @brief Definiciones de la identidad de vehículos e histogramas de latencia.
+ *
+ * @date 16 de octubre de 2026 (creación)
+ * @version 1.0
+ * @authors
+ * Julio López
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "estadisticas.h"
+
+volatile sig_atomic_t statsReportRequested = 0;
+
+/**************************************
+ *      *HISTOGRAMAS
+ *************************************/
+
+// Los valores menores a HIST_SUB_COUNT tienen intervalo propio; los demás se agrupan por potencia de 2
+// y dentro de ella en HIST_SUB_COUNT intervalos lineales.
+static int bucketIndex(long long value) {
+    if (value < HIST_SUB_COUNT) {
+        return (int)value;
+    }
+    int exponent = 63 - __builtin_clzll((unsigned long long)value);
+    int shift = exponent - HIST_SUB_BITS;
+    return shift * HIST_SUB_COUNT + (int)(value >> shift);
+}
+
+static long long bucketUpperBound(int index) {
+    if (index < HIST_SUB_COUNT) {
+        return index;
+    }
+    int shift = index / HIST_SUB_COUNT - 1;
+    long long mantissa = index % HIST_SUB_COUNT + HIST_SUB_COUNT;
+    return ((mantissa + 1) << shift) - 1;
+}
+
+void histInit(Histogram *h) {
+    memset(h, 0, sizeof(Histogram));
+}
+
+void histRecord(Histogram *h, long long value) {
+    if (value < 0) {
+        value = 0;
+    }
+    h->buckets[bucketIndex(value)]++;
+    h->count++;
+    h->sum += value;
+    if (value > h->max) {
+        h->max = value;
+    }
+}
+
+void histMerge(Histogram *dst, const Histogram *src) {
+    for (int i = 0; i < HIST_BUCKETS; i++) {
+        dst->buckets[i] += src->buckets[i];
+    }
+    dst->count += src->count;
+    dst->sum += src->sum;
+    if (src->max > dst->max) {
+        dst->max = src->max;
+    }
+}
+
+long long histPercentile(const Histogram *h, double p) {
+    if (h->count == 0) {
+        return 0;
+    }
+    long long rank = (long long)(p / 100.0 * h->count + 0.5);
+    if (rank < 1) {
+        rank = 1;
+    }
+    long long seen = 0;
+    for (int i = 0; i < HIST_BUCKETS; i++) {
+        seen += h->buckets[i];
+        if (seen >= rank) {
+            long long bound = bucketUpperBound(i);
+            return (bound < h->max) ? bound : h->max;
+        }
+    }
+    return h->max;
+}
+
+void latencyInit(LatencyStats *stats) {
+    histInit(&stats->wait);
+    histInit(&stats->bridge);
+    histInit(&stats->total);
+}
+
+static void printHistogramRow(FILE *out, const char *name, const Histogram *h) {
+    fprintf(out, "  %-20s %9lld %9.3f %9.3f %9.3f %9.3f\n", name, h->count,
+            histPercentile(h, 50) / 1e6, histPercentile(h, 90) / 1e6,
+            histPercentile(h, 99) / 1e6, h->max / 1e6);
+}
+
+static void printLatencyRows(FILE *out, const char *title, const LatencyStats stats[3]) {
+    static const char *sideNames[3] = {"", "izquierda", "derecha"};
+    char name[32];
+    fprintf(out, "%-24s       n       p50       p90       p99       max\n", title);
+    for (int side = 1; side <= 2; side++) {
+        snprintf(name, sizeof(name), "%s espera", sideNames[side]);
+        printHistogramRow(out, name, &stats[side].wait);
+        snprintf(name, sizeof(name), "%s puente", sideNames[side]);
+        printHistogramRow(out, name, &stats[side].bridge);
+        snprintf(name, sizeof(name), "%s total", sideNames[side]);
+        printHistogramRow(out, name, &stats[side].total);
+    }
+    fflush(out);
+}
+
+void printLatencyReport(FILE *out, const LatencyStats stats[3]) {
+    printLatencyRows(out, "Latencias (s)", stats);
+}
+
+void printPriorityReport(FILE *out, const LatencyStats stats[3]) {
+    if (stats[1].wait.count + stats[2].wait.count == 0) {
+        return;
+    }
+    printLatencyRows(out, "Emergencias (s)", stats);
+}
+
+static void onReportSignal(int sig) {
+    (void)sig;
+    statsReportRequested = 1;
+}
+
+void installStatsSignal() {
+    struct sigaction sa;
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = onReportSignal;
+    sigemptyset(&sa.sa_mask);
+    sa.sa_flags = SA_RESTART;
+    sigaction(SIGUSR1, &sa, NULL);
+}
+
+/**************************************
+ *      *IDENTIDAD DE LOS VEHICULOS
+ *************************************/
+
+// id = 2 * secuencia + lado, así nunca es 0 y el lado se deduce del propio identificador. La secuencia da la
+// vuelta en VEHICLE_SEQ_MASK + 1, que es múltiplo del tamaño de la tabla: el espacio de cada id no cambia.
+
+static int nextSequence(int seq) {
+    return (seq + 1) & VEHICLE_SEQ_MASK;
+}
+
+int vehicleTableInit(VehicleTable *table, int side, int capacity) {
+    int n = 1;
+    if (capacity > VEHICLE_SEQ_MASK + 1) {
+        return -1;
+    }
+    while (n < capacity) {
+        n <<= 1;
+    }
+    table->slots = calloc(n, sizeof(VehicleTimes));
+    if (table->slots == NULL) {
+        return -1;
+    }
+    table->mask = n - 1;
+    table->side = side;
+    table->nextSeq = 0;
+    table->committed = 0;
+    return 0;
+}
+
+void vehicleTableFree(VehicleTable *table) {
+    free(table->slots);
+    table->slots = NULL;
+}
+
+// live lo pone en 0 el hilo del puente (recordCrossing()); el productor del lado lo lee y lo pone en 1.
+int prepareVehicle(VehicleTable *table, long long now) {
+    while (ATOMIC_LOAD_ACQ(&table->slots[table->nextSeq & table->mask].live)) {
+        table->nextSeq = nextSequence(table->nextSeq);     // Lo adelantó una emergencia y sigue esperando.
+    }
+    VehicleTimes *slot = &table->slots[table->nextSeq & table->mask];
+    slot->arrival = now;
+    slot->dequeued = now;
+    slot->origin = now;
+    slot->priority = 0;
+    return 2 * table->nextSeq + table->side;
+}
+
+void commitVehicle(VehicleTable *table) {
+    // Se publica a quien lo saca de la cola junto con el vehículo (semáforo o cola sin bloqueo).
+    ATOMIC_STORE_REL(&table->slots[table->nextSeq & table->mask].live, 1);
+    table->nextSeq = nextSequence(table->nextSeq);
+    table->committed++;
+}
+
+int vehicleSide(int id) {
+    return ((id - 1) & 1) + 1;
+}
+
+VehicleTimes* vehicleTimes(VehicleTable *table, int id) {
+    return &table->slots[((id - 1) >> 1) & table->mask];
+}
+
+void recordDequeue(VehicleTable tables[3], LatencyStats stats[3], LatencyStats priority[3], int id, long long now) {
+    if (id <= 0) {
+        return;
+    }
+    int side = vehicleSide(id);
+    VehicleTimes *times = vehicleTimes(&tables[side], id);
+    LatencyStats *target = (times->priority && priority != NULL) ? &priority[side] : &stats[side];
+    times->dequeued = now;
+    histRecord(&target->wait, now - times->arrival);
+}
+
+void recordCrossing(VehicleTable tables[3], LatencyStats stats[3], LatencyStats priority[3], int id, long long now) {
+    if (id <= 0) {
+        return;
+    }
+    int side = vehicleSide(id);
+    VehicleTimes *times = vehicleTimes(&tables[side], id);
+    LatencyStats *target = (times->priority && priority != NULL) ? &priority[side] : &stats[side];
+    histRecord(&target->bridge, now - times->dequeued);
+    histRecord(&target->total, now - times->arrival);
+    ATOMIC_STORE_REL(&times->live, 0);
+}
@@ -0,0 +1,235 @@
+/**
+ * @file estadisticas.h
+ * @brief Identidad de los vehículos e histogramas de latencia.
+ *
+ * @details
+ * Cada vehículo que entra a una cola recibe un identificador distinto de 0 que además indica su lado, y ese
+ * identificador es lo que se guarda en los buffers en lugar del antiguo 1. Los tiempos de llegada y de salida
+ * de la cola se guardan en una tabla por lado, un arreglo circular indexado por número de secuencia. Los
+ * vehículos de un lado no salen necesariamente en el orden en que llegaron (las emergencias adelantan a los
+ * que esperan en la cola común), así que un espacio queda ocupado hasta que su vehículo termina de cruzar y
+ * la secuencia del siguiente salta los ocupados. La tabla tiene lugar para todos los vehículos que el lado
+ * puede tener a la vez, por lo que siempre hay un espacio libre. La secuencia da la vuelta en VEHICLE_SEQ_MASK,
+ * así el identificador nunca desborda un int y una corrida larga no llega a producir un 0 ni un negativo.
+ *
+ * Las latencias se acumulan en histogramas log-lineales: 16 subdivisiones lineales por cada potencia de 2, lo
+ * que da un error relativo menor a 6,25% con un costo de registro de unas pocas instrucciones.
+ *
+ * @date 16 de octubre de 2026 (creación)
+ * @version 1.0
+ * @authors
+ * Julio López
+ */
+
+#ifndef ESTADISTICAS_H
+#define ESTADISTICAS_H
+
+#include <stdio.h>
+#include <signal.h>
+#include "atomicos.h"
+
+#define HIST_SUB_BITS       4
+#define HIST_SUB_COUNT      (1 << HIST_SUB_BITS)
+#define HIST_BUCKETS        ((64 - HIST_SUB_BITS + 1) * HIST_SUB_COUNT)
+#define VEHICLE_SEQ_MASK    ((1 << 29) - 1)     // 2 * secuencia + lado cabe en un int; múltiplo de toda tabla
+
+/**
+ * @brief Histograma log-lineal de valores no negativos (microsegundos).
+ */
+typedef struct {
+    long long count;                    /**< Cantidad de valores registrados */
+    long long sum;                      /**< Suma de los valores */
+    long long max;                      /**< Máximo exacto */
+    long long buckets[HIST_BUCKETS];    /**< Conteo por intervalo */
+} Histogram;
+
+/**
+ * @brief Latencias de un lado: tiempo en la cola, en el puente y total.
+ */
+typedef struct {
+    Histogram wait;     /**< Desde que llega a la cola hasta que sale de ella */
+    Histogram bridge;   /**< Desde que sale de la cola hasta que termina de cruzar */
+    Histogram total;    /**< Desde que llega hasta que termina de cruzar */
+} LatencyStats;
+
+/**
+ * @brief Tiempos registrados de un vehículo.
+ */
+typedef struct {
+    long long arrival;  /**< Instante de llegada a la cola (us) */
+    long long dequeued; /**< Instante en que salió de la cola (us) */
+    long long origin;   /**< Instante en que entró a la red de tramos; igual a arrival fuera de ella (us) */
+    int priority;       /**< 1 si es un vehículo de emergencia (carril prioritario), 0 si no */
+    ATOMIC_INT live;    /**< 1 desde que entra a la cola hasta que termina de cruzar */
+} VehicleTimes;
+
+/**
+ * @brief Tabla de vehículos de un lado. La escribe un único productor por lado.
+ */
+typedef struct {
+    VehicleTimes *slots;    /**< Arreglo circular, cantidad potencia de 2 */
+    int mask;               /**< Cantidad de espacios - 1 */
+    int side;               /**< 1 izquierda, 2 derecha */
+    int nextSeq;            /**< Secuencia del próximo vehículo del lado, entre 0 y VEHICLE_SEQ_MASK */
+    long long committed;    /**< Vehículos confirmados del lado (las secuencias saltadas no cuentan) */
+} VehicleTable;
+
+/** Se pone en 1 al recibir SIGUSR1 para pedir un reporte de latencias. */
+extern volatile sig_atomic_t statsReportRequested;
+
+
+/**
+ * @brief Deja el histograma vacío.
+ *
+ * @param h Histograma
+ */
+void histInit(Histogram *h);
+
+
+/**
+ * @brief Registra un valor en el histograma. Los negativos se registran como 0.
+ *
+ * @param h Histograma
+ * @param value Valor en microsegundos
+ */
+void histRecord(Histogram *h, long long value);
+
+
+/**
+ * @brief Suma los conteos de src en dst.
+ *
+ * @param dst Histograma destino
+ * @param src Histograma a sumar
+ */
+void histMerge(Histogram *dst, const Histogram *src);
+
+
+/**
+ * @brief Valor bajo el cual cae el porcentaje p de los registros.
+ *
+ * @param h Histograma
+ * @param p Percentil entre 0 y 100
+ * @return long long Límite superior del intervalo del percentil, acotado por el máximo
+ */
+long long histPercentile(const Histogram *h, double p);
+
+
+/**
+ * @brief Deja vacíos los tres histogramas de un lado.
+ *
+ * @param stats Latencias de un lado
+ */
+void latencyInit(LatencyStats *stats);
+
+
+/**
+ * @brief Imprime n, p50, p90, p99 y máximo por lado, en segundos.
+ *
+ * @param out Archivo de salida
+ * @param stats Arreglo indexado por lado (se usan los índices 1 y 2)
+ */
+void printLatencyReport(FILE *out, const LatencyStats stats[3]);
+
+
+/**
+ * @brief Igual que printLatencyReport() para los vehículos de emergencia; no imprime nada si no cruzó ni
+ * salió de la cola ninguno.
+ *
+ * @param out Archivo de salida
+ * @param stats Arreglo indexado por lado (se usan los índices 1 y 2)
+ */
+void printPriorityReport(FILE *out, const LatencyStats stats[3]);
+
+
+/**
+ * @brief Instala el manejador de SIGUSR1 que pide un reporte de latencias.
+ */
+void installStatsSignal();
+
+
+/**
+ * @brief Inicializa la tabla de un lado.
+ *
+ * @param table Tabla a inicializar
+ * @param side Lado al que pertenece
+ * @param capacity Vehículos simultáneos del lado (cola + puente + uno en tránsito)
+ * @return 0 si todo salió bien, -1 si no hubo memoria
+ */
+int vehicleTableInit(VehicleTable *table, int side, int capacity);
+
+
+/**
+ * @brief Libera la memoria de la tabla.
+ *
+ * @param table Tabla a liberar
+ */
+void vehicleTableFree(VehicleTable *table);
+
+
+/**
+ * @brief Prepara el identificador del próximo vehículo y registra su llegada.
+ *
+ * El identificador solo queda asignado al llamar a commitVehicle(), así una llegada rechazada por cola
+ * llena no consume secuencia. Si el espacio de la secuencia siguiente sigue ocupado por un vehículo que fue
+ * adelantado, se salta a la primera libre.
+ *
+ * @param table Tabla del lado
+ * @param now Instante de llegada (us)
+ * @return int Identificador del vehículo, siempre mayor que 0
+ */
+int prepareVehicle(VehicleTable *table, long long now);
+
+
+/**
+ * @brief Confirma el vehículo preparado con prepareVehicle().
+ *
+ * @param table Tabla del lado
+ */
+void commitVehicle(VehicleTable *table);
+
+
+/**
+ * @brief Registra la salida de la cola de un vehículo y su tiempo de espera.
+ *
+ * @param tables Tablas indexadas por lado
+ * @param stats Latencias indexadas por lado
+ * @param priority Latencias de los vehículos de emergencia por lado; si es NULL van también a stats
+ * @param id Identificador del vehículo (0 no registra nada)
+ * @param now Instante actual (us)
+ */
+void recordDequeue(VehicleTable tables[3], LatencyStats stats[3], LatencyStats priority[3], int id, long long now);
+
+
+/**
+ * @brief Registra que un vehículo terminó de cruzar: tiempo en el puente y total. Después su espacio de la
+ * tabla queda libre para otro vehículo.
+ *
+ * @param tables Tablas indexadas por lado
+ * @param stats Latencias indexadas por lado
+ * @param priority Latencias de los vehículos de emergencia por lado; si es NULL van también a stats
+ * @param id Identificador del vehículo (0 no registra nada)
+ * @param now Instante actual (us)
+ */
+void recordCrossing(VehicleTable tables[3], LatencyStats stats[3], LatencyStats priority[3], int id, long long now);
+
+
+/**
+ * @brief Lado al que pertenece un identificador.
+ *
+ * @param id Identificador del vehículo
+ * @return int 1 izquierda, 2 derecha
+ */
+int vehicleSide(int id);
+
+
+/**
+ * @brief Tiempos registrados de un vehículo.
+ *
+ * @param table Tabla del lado del vehículo
+ * @param id Identificador del vehículo
+ * @return VehicleTimes*
+ */
+VehicleTimes* vehicleTimes(VehicleTable *table, int id);
+
+
+#endif
@@ -19,71 +19,376 @@
  * Versión 1.1 - 11 de junio de 2024 - Actualización y modificación de funciones para implementar ncurses.
  */
 
+#include <curses.h>
+#include <sched.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
 #include "funciones.h"
 
-CircularBuffer* createBuffer(int size) {
-    CircularBuffer* cb = malloc(sizeof(CircularBuffer));
-    cb->buffer = calloc(size, sizeof(int));
-    cb->size = size;
-    cb->head = 0;
-    cb->tail = 0;
-    return cb;
+int snapshotBuffer(CircularBuffer *cb, char *cells) {
+    while (1) {
+        int start = ATOMIC_LOAD_ACQ(&cb->seq);
+        if (start & 1) {
+            sched_yield();      // Hay una escritura en curso.
+            continue;
+        }
+        unsigned tail = cb->tail;
+        int count = cb->count;
+        for (int i = 0; i < cb->size; i++) {
+            cells[i] = cb->slots[(tail + i) & intRingMask] ? OCCUPIED_CHAR : EMPTY_CHAR;
+        }
+        ATOMIC_FENCE_ACQ();
+        if (ATOMIC_LOAD_RLX(&cb->seq) == start) {
+            return count;
+        }
+    }
+}
+
+void printBuffer(CircularBuffer *cb) {
+    for(int i = 0; i < cb->size; i++) {
+        if(intRingAt(cb, i)) {
+            addch(OCCUPIED_CHAR);
+        } else {
+            addch(EMPTY_CHAR);
+        }
+    }
+}
+
+void printBuffer2(CircularBuffer *cb) {
+    for(int i = (cb->size)-1; i >= 0; i--) {
+        if(intRingAt(cb, i)) {
+            addch(OCCUPIED_CHAR);
+        } else {
+            addch(EMPTY_CHAR);
+        }
+    }
 }
 
-int isBufferEmpty(CircularBuffer *cb) {
-    for (int i = 0; i < cb->size; i++) {
-        if (cb->buffer[i] != 0) {
+int tryVehicle(sem_t *items) {
+    while (sem_trywait(items) != 0) {
+        if (errno != EINTR) {
             return 0;
         }
     }
     return 1;
 }
 
-int countBuffer(CircularBuffer *cb) {
-    int count = 0;
-    for (int i = 0; i < cb->size; i++) {
-        if (cb->buffer[i] != 0) {
-            count++;
+int waitVehicle(sem_t *items, int timeoutUs) {
+    if (timeoutUs <= 0) {
+        return tryVehicle(items);
+    }
+    // sem_timedwait() recibe un instante absoluto de CLOCK_REALTIME.
+    struct timespec deadline;
+    clock_gettime(CLOCK_REALTIME, &deadline);
+    deadline.tv_sec += timeoutUs / 1000000;
+    deadline.tv_nsec += (timeoutUs % 1000000) * 1000L;
+    if (deadline.tv_nsec >= 1000000000L) {
+        deadline.tv_sec++;
+        deadline.tv_nsec -= 1000000000L;
+    }
+    while (sem_timedwait(items, &deadline) != 0) {
+        if (errno != EINTR) {
+            return 0;   // ETIMEDOUT
         }
     }
-    return count;
+    return 1;
 }
 
-void destroyBuffer(CircularBuffer *cb) {
-    if(cb != NULL) {
-        free(cb->buffer);
-        free(cb);
+static const char* messages[] = {
+    ['a'] = "   Sale alguien de la cola izquierda.",
+    ['A'] = "   Entra alguien al puente desde la cola izquierda.",
+    ['b'] = "   Sale alguien de la cola derecha.",
+    ['B'] = "   Entra alguien al puente desde la cola derecha.",
+    ['O'] = "   Un vehículo cruzó.",
+    ['l'] = "   Una nuevo vehículo espera en la cola izquierda",
+    ['r'] = "   Una nuevo vehículo espera en la cola derecha",
+    ['L'] = "   La cola izquierda está llena, el vehículo se va.",
+    ['R'] = "   La cola derecha está llena, el vehículo se va.",
+    ['*'] = "   Nadie nuevo sale de las colas.",
+    ['+'] = "   Nadie nuevo entra al puente.",
+    ['!'] = "   Emergencia del otro lado: se corta el lote."
+};
+
+const char* eventMessage(char code) {
+    if (code < 0 || (size_t)code >= sizeof(messages) / sizeof(messages[0]) || messages[(int)code] == NULL) {
+        return "   Evento desconocido.";
     }
+    return messages[(int)code];
 }
 
-void addToBuffer(CircularBuffer *cb, int value) {
-    cb->buffer[cb->head] = value;
-    cb->head = (cb->head + 1) % (cb->size);
+int computeWindowSize(int leftSize, int rightSize, int dir, const WindowParams *wp) {
+    int totalWeight = wp->focusWeight + wp->otherWeight;
+    int avgSize;
+    int newWindowSize;
+
+    // Calcula el tamaño promedio de los buffers
+    if (dir == 1) {
+        // Si la dirección es 1 (izquierda), se da más relevancia al tamaño del buffer izquierdo.
+        avgSize = (wp->focusWeight * leftSize + wp->otherWeight * rightSize) / totalWeight;
+        if (avgSize > leftSize) {
+            avgSize = leftSize;
+        }
+    } else {
+        // Si la dirección es 2 (derecha), se da más relevancia al tamaño del buffer derecho.
+        avgSize = (wp->otherWeight * leftSize + wp->focusWeight * rightSize) / totalWeight;
+        if (avgSize > rightSize) {
+            avgSize = rightSize;
+        }
+    }
+
+    // Calcula el nuevo tamaño de la ventana
+    newWindowSize = avgSize / wp->divisor;
+    if (newWindowSize > 0) {
+        if (newWindowSize > wp->maxWindow) {
+            return wp->maxWindow;   // Valor máximo para la ventana.
+        }
+        return newWindowSize;
+    }
+    return 1;                       // Valor mínimo para la ventana.
 }
 
-int removeFromBuffer(CircularBuffer *cb) {
-    int value = cb->buffer[cb->tail];
-    cb->buffer[cb->tail] = 0;
-    cb->tail = (cb->tail + 1) % (cb->size);
-    return value;
+Estacionamiento* createEstacionamiento(const SimParams *params) {
+    Estacionamiento *est;
+    if (posix_memalign((void**)&est, CACHE_LINE_SIZE, sizeof(Estacionamiento)) != 0) {
+        return NULL;
+    }
+    memset(est, 0, sizeof(Estacionamiento));
+    est->p = *params;
+
+    // Inicializar semáforos; van primero para que destroyEstacionamiento() pueda deshacer cualquier fallo.
+    sem_init(&est->leftSemaphore, 0, 1);
+    sem_init(&est->rightSemaphore, 0, 1);
+    sem_init(&est->parkingSemaphore, 0, 1);
+    sem_init(&est->leftItems, 0, 0);
+    sem_init(&est->rightItems, 0, 0);
+
+    // Inicializar buffers (NULL sin memoria o con más espacios que INT_RING_CAPACITY)
+    est->leftBuffer = createQueue(params->bufferSize);          // Cola de espera izquierda
+    est->rightBuffer = createQueue(params->bufferSize);         // Cola de espera derecha
+    est->leftPriority = createQueue(params->bufferSize);        // Carriles de emergencias
+    est->rightPriority = createQueue(params->bufferSize);
+    est->parkingBuffer = createBuffer(params->parkingSize);     // Capacidad del estacionamiento
+    if (est->leftBuffer == NULL || est->rightBuffer == NULL || est->leftPriority == NULL ||
+        est->rightPriority == NULL || est->parkingBuffer == NULL) {
+        destroyEstacionamiento(est);
+        return NULL;
+    }
+
+    // Tablas de vehículos: cada lado puede tener su cola y su carril llenos, el puente lleno y uno en tránsito
+    for (int side = 1; side <= 2; side++) {
+        if (vehicleTableInit(&est->vehicles[side], side, 2 * params->bufferSize + params->parkingSize + 2) != 0) {
+            destroyEstacionamiento(est);
+            return NULL;
+        }
+        latencyInit(&est->latency[side]);
+        latencyInit(&est->priorityLatency[side]);
+    }
+
+    ATOMIC_STORE(&est->contador_in, 0);
+    ATOMIC_STORE(&est->contador_out, 0);
+    ATOMIC_STORE(&est->window, params->windowSize);
+    est->dir = 0;
+    initPolicy(&est->sched, params->policy, &params->weights, params->parkingSpeed);
+    return est;
 }
 
-void printBuffer(CircularBuffer *cb) {
-    for(int i = 0; i < cb->size; i++) {
-        if(cb->buffer[(cb->tail + i) % (cb->size)]) {
-            addch(OCCUPIED_CHAR);
-        } else {
-            addch(EMPTY_CHAR);
+void destroyEstacionamiento(Estacionamiento *est) {
+    if (est == NULL) {
+        return;
+    }
+    sem_destroy(&est->leftSemaphore);
+    sem_destroy(&est->rightSemaphore);
+    sem_destroy(&est->parkingSemaphore);
+    sem_destroy(&est->leftItems);
+    sem_destroy(&est->rightItems);
+    destroyQueue(est->leftBuffer);
+    destroyQueue(est->rightBuffer);
+    destroyQueue(est->leftPriority);
+    destroyQueue(est->rightPriority);
+    destroyBuffer(est->parkingBuffer);
+    vehicleTableFree(&est->vehicles[1]);
+    vehicleTableFree(&est->vehicles[2]);
+    free(est);
+}
+
+/**************************************
+ *      *BUFFER SIN BLOQUEO (SPSC)
+ *************************************/
+
+SpscBuffer* createSpscBuffer(int size) {
+    SpscBuffer* sb;
+    if (posix_memalign((void**)&sb, CACHE_LINE_SIZE, sizeof(SpscBuffer)) != 0) {
+        return NULL;
+    }
+    sb->buffer = calloc(size + 1, sizeof(int));
+    if (sb->buffer == NULL) {
+        free(sb);
+        return NULL;
+    }
+    sb->size = size;
+    ATOMIC_STORE(&sb->head, 0);
+    ATOMIC_STORE(&sb->tail, 0);
+    sb->cachedTail = 0;
+    sb->cachedHead = 0;
+    return sb;
+}
+
+void destroySpscBuffer(SpscBuffer *sb) {
+    if(sb != NULL) {
+        free(sb->buffer);
+        free(sb);
+    }
+}
+
+int spscAdd(SpscBuffer *sb, int value) {
+    int head = ATOMIC_LOAD_RLX(&sb->head);
+    int next = (head == sb->size) ? 0 : head + 1;
+    if (next == sb->cachedTail) {
+        // Solo se lee la tail compartida cuando la copia local indica lleno.
+        sb->cachedTail = ATOMIC_LOAD_ACQ(&sb->tail);
+        if (next == sb->cachedTail) {
+            return 0;
         }
     }
+    sb->buffer[head] = value;
+    ATOMIC_STORE_REL(&sb->head, next);  // Publica el dato escrito.
+    return 1;
 }
 
-void printBuffer2(CircularBuffer *cb) {
-    for(int i = (cb->size)-1; i >= 0; i--) {
-        if(cb->buffer[(cb->tail + i) % (cb->size)]) {
-            addch(OCCUPIED_CHAR);
-        } else {
-            addch(EMPTY_CHAR);
+int spscRemove(SpscBuffer *sb) {
+    int tail = ATOMIC_LOAD_RLX(&sb->tail);
+    if (tail == sb->cachedHead) {
+        sb->cachedHead = ATOMIC_LOAD_ACQ(&sb->head);
+        if (tail == sb->cachedHead) {
+            return 0;
         }
     }
+    int value = sb->buffer[tail];
+    ATOMIC_STORE_REL(&sb->tail, (tail == sb->size) ? 0 : tail + 1);  // Libera el espacio.
+    return value;
+}
+
+int spscAddMany(SpscBuffer *sb, const int *values, int n) {
+    int slots = sb->size + 1;
+    int head = ATOMIC_LOAD_RLX(&sb->head);
+    int space = (sb->cachedTail - head - 1 + slots) % slots;
+    if (space < n) {
+        sb->cachedTail = ATOMIC_LOAD_ACQ(&sb->tail);
+        space = (sb->cachedTail - head - 1 + slots) % slots;
+    }
+    if (n > space) {
+        n = space;
+    }
+    if (n <= 0) {
+        return 0;
+    }
+    int first = (n < slots - head) ? n : slots - head;
+    memcpy(&sb->buffer[head], values, first * sizeof(int));
+    memcpy(sb->buffer, values + first, (n - first) * sizeof(int));
+    ATOMIC_STORE_REL(&sb->head, (head + n) % slots);    // Publica todos los datos juntos.
+    return n;
+}
+
+int spscRemoveMany(SpscBuffer *sb, int *out, int n) {
+    int slots = sb->size + 1;
+    int tail = ATOMIC_LOAD_RLX(&sb->tail);
+    int available = (sb->cachedHead - tail + slots) % slots;
+    if (available < n) {
+        sb->cachedHead = ATOMIC_LOAD_ACQ(&sb->head);
+        available = (sb->cachedHead - tail + slots) % slots;
+    }
+    if (n > available) {
+        n = available;
+    }
+    if (n <= 0) {
+        return 0;
+    }
+    int first = (n < slots - tail) ? n : slots - tail;
+    memcpy(out, &sb->buffer[tail], first * sizeof(int));
+    memcpy(out + first, sb->buffer, (n - first) * sizeof(int));
+    ATOMIC_STORE_REL(&sb->tail, (tail + n) % slots);    // Libera todos los espacios juntos.
+    return n;
+}
+
+int spscPeek(SpscBuffer *sb) {
+    int tail = ATOMIC_LOAD_RLX(&sb->tail);
+    if (tail == ATOMIC_LOAD_ACQ(&sb->head)) {
+        return 0;
+    }
+    return sb->buffer[tail];
+}
+
+int spscCount(SpscBuffer *sb) {
+    int head = ATOMIC_LOAD_ACQ(&sb->head);
+    int tail = ATOMIC_LOAD_ACQ(&sb->tail);
+    int count = head - tail;
+    return (count < 0) ? count + sb->size + 1 : count;
+}
+
+void printSpscBuffer(SpscBuffer *sb) {
+    // Los elementos siempre están contiguos desde tail, basta con la cantidad.
+    int count = spscCount(sb);
+    for(int i = 0; i < sb->size; i++) {
+        addch((i < count) ? OCCUPIED_CHAR : EMPTY_CHAR);
+    }
+}
+
+void printSpscBuffer2(SpscBuffer *sb) {
+    int count = spscCount(sb);
+    for(int i = (sb->size)-1; i >= 0; i--) {
+        addch((i < count) ? OCCUPIED_CHAR : EMPTY_CHAR);
+    }
+}
+
+int snapshotSpscBuffer(SpscBuffer *sb, char *cells) {
+    int count = spscCount(sb);
+    for (int i = 0; i < sb->size; i++) {
+        cells[i] = (i < count) ? OCCUPIED_CHAR : EMPTY_CHAR;
+    }
+    return count;
+}
+
+/**************************************
+ *      *HISTORIAL DE MENSAJES SIN BLOQUEO
+ *************************************/
+
+void initMessageRing(MessageRing *ring) {
+    ATOMIC_STORE(&ring->head, 0);
+    for (int i = 0; i < MESSAGE_RING_SIZE; i++) {
+        ATOMIC_STORE(&ring->records[i].seq, 0);
+        ring->records[i].code = 0;
+        ring->records[i].value = 0;
+    }
+}
+
+void logMessage(MessageRing *ring, char code, int value) {
+    int pos = ATOMIC_ADD(&ring->head, 1);
+    MessageRecord *r = &ring->records[pos & (MESSAGE_RING_SIZE - 1)];
+    ATOMIC_STORE_RLX(&r->seq, 0);           // Incompleto mientras se escribe.
+    ATOMIC_FENCE_REL();
+    r->code = code;
+    r->value = value;
+    ATOMIC_STORE_REL(&r->seq, pos + 1);
+}
+
+int recentMessages(MessageRing *ring, MessageRecord *out, int n) {
+    int head = ATOMIC_LOAD_ACQ(&ring->head);
+    int count = 0;
+    if (n > MESSAGE_RING_SIZE) {
+        n = MESSAGE_RING_SIZE;
+    }
+    for (int pos = (head > n) ? head - n : 0; pos < head; pos++) {
+        MessageRecord *r = &ring->records[pos & (MESSAGE_RING_SIZE - 1)];
+        if (ATOMIC_LOAD_ACQ(&r->seq) != pos + 1) {
+            continue;       // Todavía se está escribiendo, o ya lo pisó una vuelta nueva.
+        }
+        out[count].code = r->code;
+        out[count].value = r->value;
+        ATOMIC_FENCE_ACQ();
+        if (ATOMIC_LOAD_RLX(&r->seq) == pos + 1) {
+            count++;
+        }
+    }
+    return count;
 }
\ No newline at end of file
@@ -28,95 +28,251 @@
 #include <stdlib.h>
 #include <unistd.h>
 #include <time.h>
+#include "atomicos.h"
+#include "estadisticas.h"
+#include "politicas.h"
+#include "aleatorio.h"
+#include "temporizador.h"
+#include "contencion.h"
 
 #define OCCUPIED_CHAR       'X'
 #define EMPTY_CHAR          '_'
 #define MESSAGE_BUFFER_SIZE 25  // Puede ajustarse este valor según sus necesidades
 
+#define CACHE_LINE_SIZE     64  // Para separar datos escritos por hilos distintos
 
-/* Esto se hace porque Aragorn no incluye <stdatomic.h>*/
-#if __GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9)
-    #include <stdatomic.h>
-    #define ATOMIC_INT atomic_int
-    #define ATOMIC_LOAD(ptr) atomic_load(ptr)
-    #define ATOMIC_STORE(ptr, val) atomic_store(ptr, val)
-    #define ATOMIC_ADD(ptr, val) atomic_fetch_add(ptr, val)
-#else
-    #define ATOMIC_INT volatile int
-    #define ATOMIC_LOAD(ptr) __sync_fetch_and_add(ptr, 0)
-    #define ATOMIC_STORE(ptr, val) __sync_bool_compare_and_swap(ptr, *ptr, val)
-    #define ATOMIC_ADD(ptr, val) __sync_fetch_and_add(ptr, val)
-#endif
+/* Suma 1 a un contador que escribe un solo hilo: lectura y escritura relajadas, sin instrucción atómica de
+   lectura-modificación-escritura. Los demás hilos solo lo leen. */
+#define COUNTER_INC(ptr)    ATOMIC_STORE_RLX(ptr, ATOMIC_LOAD_RLX(ptr) + 1)
+
+/* Emergencias seguidas que el puente saca de un lado mientras espera un vehículo común del mismo lado; después
+   pasa el común. Como además un lote admite al menos un vehículo antes de que lo corte una emergencia del otro
+   lado, el tráfico común no queda detenido indefinidamente. */
+#define PRIORITY_BURST      4
 
+#include "anillo.h"
+
+#define INT_SLOT_EMPTY(x)   ((x) == 0)
+#ifndef INT_RING_CAPACITY
+#define INT_RING_CAPACITY   1024    // Potencia de 2; ninguna cola ni puente puede tener más (make RING_CAPACITY=)
+#endif
 
 /**
- * @brief Estructura para un buffer circular con un tamaño configurable.
+ * @brief Buffer circular de enteros: las colas de espera y los espacios del puente.
  *
- * @param buffer Puntero a un arreglo de enteros donde almacenar los datos.
- * @param head Indice a la cabeza del buffer (donde se añaden nuevos datos).
- * @param tail Indice a la cola del buffer (donde se retiran los datos).
- * @param size Tamaño del buffer.
+ * Guarda números de vehículo; 0 marca un espacio libre. Es una instancia de RING_DEFINE() (ver anillo.h) de
+ * INT_RING_CAPACITY espacios: los índices se envuelven con una máscara constante y los datos van en la misma
+ * reserva que la cabecera. createBuffer() devuelve NULL si se piden más espacios; make RING_CAPACITY=n compila
+ * con otra capacidad, que debe ser potencia de 2.
+ *
+ * Las escrituras deben estar serializadas por quien usa el buffer (semáforo o un único hilo), pero
+ * cualquier hilo puede leer una copia consistente con snapshotBuffer() sin tomar ningún bloqueo: es la
+ * única instancia con seqlock.
  */
-typedef struct {
-    int* buffer;  /**< Puntero a un arreglo de enteros donde almacenar los datos */
-    int head;     /**< Indice a la cabeza del buffer (donde se añaden nuevos datos) */
-    int tail;     /**< Indice a la cola del buffer (donde se retiran los datos) */
-    int size;     /**< Tamaño del buffer */
-} CircularBuffer;
+RING_DEFINE(CircularBuffer, intRing, int, INT_RING_CAPACITY, 0, INT_SLOT_EMPTY, 1)
+
+/* Nombres de siempre para las operaciones del buffer de enteros */
+#define createBuffer(size)                  intRingCreate(size)
+#define destroyBuffer(cb)                   intRingDestroy(cb)
+#define isBufferEmpty(cb)                   intRingIsEmpty(cb)
+#define isBufferFull(cb)                    intRingIsFull(cb)
+#define countBuffer(cb)                     intRingCount(cb)
+#define addToBuffer(cb, value)              intRingAdd(cb, value)
+#define removeFromBuffer(cb)                intRingRemove(cb)
+#define addManyToBuffer(cb, values, n)      intRingAddMany(cb, values, n)
+#define removeManyFromBuffer(cb, out, n)    intRingRemoveMany(cb, out, n)
+#define shiftBuffer(cb, value)              intRingShift(cb, value)
+#define rotateBuffer(cb)                    intRingRotate(cb)
+#define peekBuffer(cb)                      intRingPeek(cb)
 
 
 /**
- * @brief Inicializa un nuevo Buffer Circular
+ * @brief Variante sin bloqueo del buffer circular para un productor y un consumidor.
  *
- * @param size Largo del buffer
- * @return CircularBuffer* Puntero al buffer circular.
+ * Solo el productor escribe head y solo el consumidor escribe tail, por lo que no se
+ * necesitan semáforos: la publicación de un dato usa release y su lectura acquire.
+ * Cada índice vive en su propia línea de caché junto a la copia local del índice
+ * contrario, para que productor y consumidor no se invaliden la línea mutuamente.
+ * Se reserva un espacio extra para distinguir lleno de vacío.
  */
-CircularBuffer* createBuffer(int size);
+typedef struct {
+    ATOMIC_INT head;    /**< Próximo espacio a escribir (solo el productor) */
+    int cachedTail;     /**< Última tail vista por el productor */
+    char pad0[CACHE_LINE_SIZE - sizeof(ATOMIC_INT) - sizeof(int)];
+    ATOMIC_INT tail;    /**< Próximo espacio a leer (solo el consumidor) */
+    int cachedHead;     /**< Última head vista por el consumidor */
+    char pad1[CACHE_LINE_SIZE - sizeof(ATOMIC_INT) - sizeof(int)];
+    int* buffer;        /**< Arreglo de size + 1 espacios */
+    int size;           /**< Capacidad útil del buffer */
+} SpscBuffer;
+
+
+/* La cola de espera se elige al compilar: make QUEUE=spsc usa la variante sin bloqueo */
+#ifdef SPSC_QUEUE
+    typedef SpscBuffer WaitQueue;
+    #define createQueue(size)       createSpscBuffer(size)
+    #define destroyQueue(q)         destroySpscBuffer(q)
+    #define queueAdd(q, value)      spscAdd(q, value)
+    #define queueRemove(q)          spscRemove(q)
+    #define queueAddMany(q, v, n)   spscAddMany(q, v, n)
+    #define queueRemoveMany(q, o, n) spscRemoveMany(q, o, n)
+    #define queuePeek(q)            spscPeek(q)
+    #define queueCount(q)           spscCount(q)
+    #define queueIsEmpty(q)         (spscCount(q) == 0)
+    #define printQueue(q)           printSpscBuffer(q)
+    #define printQueue2(q)          printSpscBuffer2(q)
+    #define snapshotQueue(q, cells) snapshotSpscBuffer(q, cells)
+    #define QUEUE_LOCK(sem)         ((void)(sem))
+    #define QUEUE_UNLOCK(sem)       ((void)(sem))
+#else
+    typedef CircularBuffer WaitQueue;
+    #define createQueue(size)       createBuffer(size)
+    #define destroyQueue(q)         destroyBuffer(q)
+    #define queueAdd(q, value)      addToBuffer(q, value)
+    #define queueRemove(q)          removeFromBuffer(q)
+    #define queueAddMany(q, v, n)   addManyToBuffer(q, v, n)
+    #define queueRemoveMany(q, o, n) removeManyFromBuffer(q, o, n)
+    #define queuePeek(q)            peekBuffer(q)
+    #define queueCount(q)           countBuffer(q)
+    #define queueIsEmpty(q)         isBufferEmpty(q)
+    #define printQueue(q)           printBuffer(q)
+    #define printQueue2(q)          printBuffer2(q)
+    #define snapshotQueue(q, cells) snapshotBuffer(q, cells)
+    #define QUEUE_LOCK(sem)         PROFILED_SEM_WAIT(sem)
+    #define QUEUE_UNLOCK(sem)       PROFILED_SEM_POST(sem)
+#endif
 
 
 /**
- * @brief Si se encuentra un elemento distinto de 0, el buffer no está vacío (retorna 0).
- * Caso contrario está vacío (retorna 1).
+ * @brief Historial de mensajes sin bloqueo para varios productores.
  *
- * @param cb Buffer a revisar
- * @return El estado del buffer
+ * Arreglo circular contiguo de registros pequeños (código y valor), sin texto: el mensaje se arma recién
+ * al dibujar la línea con eventMessage(). Un productor reserva la posición con un incremento atómico y
+ * escribe el registro como un seqlock propio (secuencia en 0, campos, secuencia = posición + 1), así que
+ * nunca espera a otro hilo. Cuando el anillo da la vuelta se pisan los registros más viejos; quien lee
+ * descarta los que cambiaron mientras los copiaba.
  */
-int isBufferEmpty(CircularBuffer *cb);
+typedef struct {
+    ATOMIC_INT seq;     /**< Posición + 1 del registro guardado, 0 mientras se escribe */
+    char code;          /**< Código del evento, el mismo que recibe printState() */
+    int value;          /**< Valor asociado al evento */
+} MessageRecord;
+
+#define MESSAGE_RING_SIZE   32      // Potencia de 2 mayor o igual a MESSAGE_BUFFER_SIZE
+
+typedef struct {
+    ATOMIC_INT head;    /**< Registros escritos desde el inicio */
+    char pad[CACHE_LINE_SIZE - sizeof(ATOMIC_INT)];
+    MessageRecord records[MESSAGE_RING_SIZE];
+} MessageRing;
+
+
 
 
 /**
- * @brief Cuenta cuantos espacios están ocupados en el buffer.
- *
- * @param cb
- * @return int
+ * @brief Parámetros de una corrida, compartidos por los hilos y la simulación de eventos.
  */
-int countBuffer(CircularBuffer *cb);
+typedef struct {
+    int bufferSize;         /**< Capacidad de cada cola de espera */
+    int parkingSize;        /**< Capacidad del puente */
+    int windowSize;         /**< Ventana inicial */
+    int parkingSpeed;       /**< Tiempo en microsegundos para avanzar un espacio */
+    int arrivalMin[3];      /**< Espera mínima entre llegadas por lado (us, índices 1 y 2) */
+    int arrivalSpread[3];   /**< Rango de la parte aleatoria de la espera por lado (us) */
+    ArrivalKind arrival;    /**< Distribución de la espera entre llegadas */
+    int gates;              /**< Fuentes de llegada por lado; entre todas mantienen la tasa del lado */
+    WindowParams weights;   /**< Heurística de ventana */
+    PolicyKind policy;      /**< Política de dirección y ventana */
+    int admitTimeout;       /**< Espera máxima por un vehículo antes de cerrar el lote (us, 0: no espera) */
+    int pipelined;          /**< 1: el puente funciona como tubería (crossPipelined), 0: por lotes */
+    int bulk;               /**< 1: en modo por lotes, el lote sale de la cola en una sola sección crítica */
+    double priorityShare;   /**< Fracción de las llegadas que son vehículos de emergencia (0: ninguna) */
+    long long maxVehicles;  /**< La corrida termina cuando cruzan más de maxVehicles */
+    long long maxDuration;  /**< No empieza otro lote después de este instante de la corrida (us, 0: sin límite) */
+    unsigned long long seed;    /**< Semilla de los generadores de llegadas (ver aleatorio.h) */
+    int verbose;            /**< Si es distinto de 0 se imprime cada evento */
+} SimParams;
 
 
 /**
- * @brief Borra un buffer al liberar su memoria.
+ * @brief Contadores de las llegadas de un lado. Los escribe solo el hilo que entrega las llegadas de ese lado
+ * (COUNTER_INC) y cada lado ocupa su propia línea de caché; quien publica estadísticas los lee y los suma
+ * fuera del camino caliente.
+ */
+typedef struct {
+    ATOMIC_LLONG arrivals;          /**< Llegadas, incluidas las rechazadas */
+    ATOMIC_LLONG rejected;          /**< Llegadas rechazadas por cola llena */
+} __attribute__((aligned(CACHE_LINE_SIZE))) SideCounters;
+
+/**
+ * @brief Estado de una instancia del estacionamiento con hilos: colas, semáforos, ventana y contadores.
  *
- * @param cb Buffer a liberar
+ * Cada instancia se reserva alineada a una línea de caché para que dos instancias nunca compartan líneas.
+ * Lo que escribe el hilo del puente y lo que escriben los productores va en líneas distintas.
  */
-void destroyBuffer(CircularBuffer *cb);
+typedef struct {
+    /* Colas de espera */
+    WaitQueue *leftBuffer;          /**< Cola de espera izquierda */
+    WaitQueue *rightBuffer;         /**< Cola de espera derecha */
+    WaitQueue *leftPriority;        /**< Carril de emergencias izquierdo, se atiende antes que leftBuffer */
+    WaitQueue *rightPriority;       /**< Carril de emergencias derecho, se atiende antes que rightBuffer */
+    CircularBuffer *parkingBuffer;  /**< Espacios del puente */
+
+    /* Semáforos */
+    sem_t leftSemaphore;            /**< Protege la cola izquierda */
+    sem_t rightSemaphore;           /**< Protege la cola derecha */
+    sem_t parkingSemaphore;         /**< Paso por el puente */
+    sem_t leftItems;                /**< Vehículos en la cola izquierda que el puente aún no reservó */
+    sem_t rightItems;               /**< Vehículos en la cola derecha que el puente aún no reservó */
+
+    /* Los escriben productores y puente */
+    ATOMIC_INT contador_in;         /**< En 1 indica a los productores y al puente que terminen */
+    ATOMIC_INT priorityWaiting[3];  /**< Vehículos en cada carril de emergencias, el puente los lee sin bloqueo */
+
+    /* Contadores del puente, solo los escribe su hilo */
+    ATOMIC_INT contador_out __attribute__((aligned(CACHE_LINE_SIZE)));  /**< Vehículos que cruzaron */
+    ATOMIC_INT window;              /**< Tamaño de la ventana actual */
+    ATOMIC_LLONG flips;             /**< Cambios de dirección */
+    ATOMIC_LLONG preemptions;       /**< Lotes cortados por una emergencia del lado contrario */
+    int dir;                        /**< Dirección actual (0 al inicio, 1 izquierda, 2 derecha) */
+    int priorityStreak[3];          /**< Emergencias seguidas que salieron de cada lado (ver PRIORITY_BURST) */
+
+    /* Contadores de los productores, uno por lado (índices 1 y 2) */
+    SideCounters sides[3];
+
+    SimParams p;                    /**< Parámetros de la instancia */
+    SchedPolicy sched;              /**< Decide dirección y ventana al terminar cada lote */
+
+    /* Identidad de los vehículos y latencias por lado (índices 1 y 2) */
+    VehicleTable vehicles[3];
+    LatencyStats latency[3];
+    LatencyStats priorityLatency[3];    /**< Latencias de los vehículos de emergencia */
+} Estacionamiento;
 
 
 /**
- * @brief Añade un valor al buffer circular.
- *
- * @param cb Un puntero al buffer circular
- * @param value El valor a añadir
+ * @brief Una fuente de llegadas (una puerta de un lado), agendada en la rueda de arrivalScheduler().
  */
-void addToBuffer(CircularBuffer *cb, int value);
+typedef struct {
+    Estacionamiento *est;   /**< Instancia */
+    int side;               /**< 1 izquierda, 2 derecha */
+    Rng rng;                /**< Generador propio: la puerta g del lado "side" usa el flujo 2 * g + side */
+    long long deadline;     /**< Próxima llegada en microsegundos, absoluta para no acumular atrasos */
+    TimerNode node;         /**< Nodo en la rueda de temporizadores */
+} Productor;
 
 
 /**
- * @brief Retira un valor del buffer circular.
+ * @brief Copia el estado de ocupación del buffer sin tomar bloqueos.
  *
- * @param cb Un puntero al buffer circular
- * @return El valor retirado del buffer
+ * Escribe en "cells" un OCCUPIED_CHAR o EMPTY_CHAR por espacio, en el mismo orden que printBuffer().
+ * Si un escritor modifica el buffer durante la copia, la copia se repite.
+ *
+ * @param cb Buffer a copiar
+ * @param cells Arreglo de al menos cb->size caracteres
+ * @return int Cantidad de espacios ocupados en la copia
  */
-int removeFromBuffer(CircularBuffer *cb);
+int snapshotBuffer(CircularBuffer *cb, char *cells);
 
 
 /**
@@ -135,24 +291,175 @@ void printBuffer(CircularBuffer *cb);
 void printBuffer2(CircularBuffer *cb);
 
 
+/**
+ * @brief Inicializa un buffer sin bloqueo para un productor y un consumidor.
+ *
+ * @param size Capacidad del buffer
+ * @return SpscBuffer* Puntero al buffer, alineado a una línea de caché.
+ */
+SpscBuffer* createSpscBuffer(int size);
+
+
+/**
+ * @brief Borra un buffer sin bloqueo al liberar su memoria.
+ *
+ * @param sb Buffer a liberar
+ */
+void destroySpscBuffer(SpscBuffer *sb);
+
+
+/**
+ * @brief Añade un valor al buffer. Solo debe llamarlo el hilo productor.
+ *
+ * @param sb Un puntero al buffer
+ * @param value El valor a añadir
+ * @return 1 si se añadió el valor, 0 si el buffer estaba lleno
+ */
+int spscAdd(SpscBuffer *sb, int value);
+
+
+/**
+ * @brief Retira un valor del buffer. Solo debe llamarlo el hilo consumidor.
+ *
+ * @param sb Un puntero al buffer
+ * @return El valor retirado, o 0 si el buffer estaba vacío
+ */
+int spscRemove(SpscBuffer *sb);
+
+
+/**
+ * @brief Añade hasta n valores con una sola publicación. Solo debe llamarlo el hilo productor.
+ *
+ * @param sb Un puntero al buffer
+ * @param values Valores a añadir
+ * @param n Cantidad de valores
+ * @return Cantidad añadida, menos que n si el buffer se llenó
+ */
+int spscAddMany(SpscBuffer *sb, const int *values, int n);
+
+
+/**
+ * @brief Retira hasta n valores con una sola liberación. Solo debe llamarlo el hilo consumidor.
+ *
+ * @param sb Un puntero al buffer
+ * @param out Arreglo de al menos n espacios para los valores retirados
+ * @param n Cantidad máxima a retirar
+ * @return Cantidad retirada, menos que n si el buffer se vació
+ */
+int spscRemoveMany(SpscBuffer *sb, int *out, int n);
+
+
+/**
+ * @brief Valor que retiraría spscRemove(), sin retirarlo. Solo debe llamarlo el hilo consumidor.
+ *
+ * @param sb Un puntero al buffer
+ * @return El primer valor, o 0 si el buffer está vacío
+ */
+int spscPeek(SpscBuffer *sb);
+
+
+/**
+ * @brief Cuenta los elementos del buffer. Puede llamarse desde cualquier hilo,
+ * el resultado es una foto del momento.
+ *
+ * @param sb Un puntero al buffer
+ * @return int
+ */
+int spscCount(SpscBuffer *sb);
+
+
+/**
+ * @brief Muestra el contenido del buffer sin bloqueo.
+ *
+ * @param sb Un puntero al buffer
+ */
+void printSpscBuffer(SpscBuffer *sb);
+
+
+/**
+ * @brief Muestra el contenido del buffer sin bloqueo en sentido opuesto.
+ *
+ * @param sb Un puntero al buffer
+ */
+void printSpscBuffer2(SpscBuffer *sb);
+
+
+/**
+ * @brief Copia el estado de ocupación del buffer sin bloqueo, en el orden de printSpscBuffer().
+ *
+ * @param sb Buffer a copiar
+ * @param cells Arreglo de al menos sb->size caracteres
+ * @return int Cantidad de elementos en la copia
+ */
+int snapshotSpscBuffer(SpscBuffer *sb, char *cells);
+
+
+/**
+ * @brief Deja el historial vacío.
+ *
+ * @param ring Historial a inicializar
+ */
+void initMessageRing(MessageRing *ring);
+
+
+/**
+ * @brief Agrega un evento al historial. Puede llamarse desde cualquier hilo y nunca bloquea.
+ *
+ * @param ring Historial de mensajes
+ * @param code Código del evento
+ * @param value Valor asociado
+ */
+void logMessage(MessageRing *ring, char code, int value);
+
+
+/**
+ * @brief Copia los últimos eventos completos del historial, del más viejo al más nuevo.
+ *
+ * @param ring Historial de mensajes
+ * @param out Arreglo de al menos n registros; solo se llenan code y value
+ * @param n Cantidad máxima de eventos, hasta MESSAGE_RING_SIZE
+ * @return int Cantidad de eventos copiados
+ */
+int recentMessages(MessageRing *ring, MessageRecord *out, int n);
+
+
+/**
+ * @brief Crea una instancia del estacionamiento con las colas vacías y los semáforos inicializados.
+ *
+ * @param params Parámetros de la instancia
+ * @return Estacionamiento* La instancia, o NULL si no hubo memoria o algún tamaño pasa de INT_RING_CAPACITY
+ */
+Estacionamiento* createEstacionamiento(const SimParams *params);
+
+
+/**
+ * @brief Libera una instancia del estacionamiento.
+ *
+ * @param est Instancia a liberar
+ */
+void destroyEstacionamiento(Estacionamiento *est);
+
+
 /**
  * @brief Vacía la cola correspondiente.
  *
  * Esta función vacía la cola al permitirle a los vehículos transitar por la salida.
  *
+ * @param arg La instancia (Estacionamiento*) que recorre.
  */
-void* recorrerEstacionamiento(void*);
+void* recorrerEstacionamiento(void* arg);
 
 
 /**
  * @brief Representa a la llegada de gente.
  *
- * Tras un periodo de tiempo se añade un nuevo vehículo a la cola designada por el argumento de entrada "arg".
+ * Un solo hilo atiende todas las fuentes de llegada (p.gates por lado) con una rueda de temporizadores:
+ * duerme con clock_nanosleep() hasta el próximo vencimiento y añade a su cola cada vehículo que llegó.
  *
- * @param arg Id del buffer, indica si es izquierda o derecha.
+ * @param arg La instancia (Estacionamiento*).
  * @return void*
  */
-void* newVehiculo(void* arg);
+void* arrivalScheduler(void* arg);
 
 
 /**
@@ -161,6 +468,15 @@ void* newVehiculo(void* arg);
 void printState(char variable, int value);
 
 
+/**
+ * @brief Hilo de dibujo: redibuja la pantalla a tasa fija con los eventos publicados por los demás hilos.
+ *
+ * @param arg No se usa.
+ * @return void*
+ */
+void* renderLoop(void* arg);
+
+
 /**
  * @brief Función auxiliar para mostrar en la consola con ncurses
  */
@@ -168,13 +484,22 @@ void printBuffersAndDirection();
 
 
 /**
- * @brief Crea una espera en micro segundos.
+ * @brief Crea una espera en micro segundos. Termina antes si se pidió terminar la corrida.
  *
  * @param microseconds
  */
 void my_sleep(int microseconds);
 
 
+/**
+ * @brief Espera hasta un instante absoluto, en microsegundos desde el inicio (ver get_time_us()). Termina
+ * antes si se pidió terminar la corrida.
+ *
+ * @param microseconds
+ */
+void sleep_until_us(long long microseconds);
+
+
 /**
  * @brief Obtiene el tiempo actual.
  *
@@ -184,13 +509,65 @@ double get_time();
 
 
 /**
- * @brief Actualiza el tamaño de la ventana de acuerdo a los tamaños de los buffers.
+ * @brief Reserva un vehículo de una cola, esperando a lo sumo timeoutUs a que llegue uno.
+ *
+ * "items" cuenta los vehículos encolados: el productor lo incrementa después de queueAdd() y el puente lo
+ * decrementa aquí antes de queueRemove(), así nunca retira de una cola vacía. La espera usa sem_timedwait(),
+ * que en Linux duerme en un futex sin consumir CPU.
+ *
+ * @param items Semáforo contador de la cola
+ * @param timeoutUs Espera máxima en microsegundos (0 o menos equivale a tryVehicle())
+ * @return 1 si se reservó un vehículo, 0 si venció el plazo con la cola vacía
+ */
+int waitVehicle(sem_t *items, int timeoutUs);
+
+
+/**
+ * @brief Reserva un vehículo de una cola sin esperar.
+ *
+ * @param items Semáforo contador de la cola
+ * @return 1 si se reservó un vehículo, 0 si la cola estaba vacía
+ */
+int tryVehicle(sem_t *items);
+
+
+/**
+ * @brief Texto que se muestra en pantalla para un código de evento de printState().
+ *
+ * @param code Código del evento
+ * @return const char* Mensaje, nunca NULL
+ */
+const char* eventMessage(char code);
+
+
+/**
+ * @brief Calcula el tamaño de la ventana a partir del largo de las colas.
+ *
+ * Es la heurística usada tanto por el hilo del puente como por la simulación de eventos.
+ *
+ * @param leftSize Vehículos esperando en la cola izquierda.
+ * @param rightSize Vehículos esperando en la cola derecha.
+ * @param dir Dirección actual (1 izquierda, 2 derecha).
+ * @param wp Pesos de la heurística.
+ * @return int El nuevo tamaño de ventana, entre 1 y wp->maxWindow.
+ */
+int computeWindowSize(int leftSize, int rightSize, int dir, const WindowParams *wp);
+
+
+/**
+ * @brief Obtiene el tiempo transcurrido desde el inicio en microsegundos.
+ *
+ * @return long long
+ */
+long long get_time_us();
+
+
+/**
+ * @brief Decide la dirección y la ventana del siguiente lote con la política de la instancia.
  *
- * @param leftBuf El buffer izquierdo.
- * @param rightBuf El buffer derecho.
- * @param dir Dirección actual.
+ * @param est La instancia, se actualizan su dirección y su ventana.
  */
-void updateWindowSize(CircularBuffer *leftBuf, CircularBuffer *rightBuf);
+void nextBatch(Estacionamiento *est);
 
 
 #endif
\ No newline at end of file
@@ -0,0 +1,224 @@
+/**
+ * @file instalacion.c
+ * @brief Definiciones de la instalación con varios puentes.
+ *
+ * @date 16 de octubre de 2026 (creación)
+ * @version 1.0
+ * @authors
+ * Julio López
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "instalacion.h"
+#include "barrido.h"
+
+#define FACILITY_LINE_SIZE  1024
+
+/**************************************
+ *      *ARCHIVO
+ *************************************/
+
+// Índice de la clave de "tok" ("clave=valor") en extraKeys, o -1.
+static int findExtraKey(const char *tok, const char *const *extraKeys) {
+    const char *eq = strchr(tok, '=');
+    for (int i = 0; extraKeys != NULL && extraKeys[i] != NULL && eq != NULL; i++) {
+        size_t len = strlen(extraKeys[i]);
+        if ((size_t)(eq - tok) == len && strncmp(tok, extraKeys[i], len) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+int parseBridgeLine(char *line, const SimParams *base, char *name, SimParams *p, const char *const *extraKeys,
+                    char **extraValues) {
+    for (int i = 0; extraKeys != NULL && extraKeys[i] != NULL; i++) {
+        extraValues[i] = NULL;
+    }
+    char *comment = strchr(line, '#');
+    if (comment != NULL) {
+        *comment = '\0';
+    }
+    char *save = NULL;
+    char *first = strtok_r(line, " \t\r\n", &save);
+    if (first == NULL) {
+        return 0;
+    }
+    snprintf(name, FACILITY_NAME_SIZE, "%s", first);
+
+    // El resto de la línea es una especificación del barrido; los espacios valen como ';'.
+    char spec[FACILITY_LINE_SIZE] = "";
+    for (char *tok = strtok_r(NULL, " \t\r\n", &save); tok != NULL; tok = strtok_r(NULL, " \t\r\n", &save)) {
+        int extra = findExtraKey(tok, extraKeys);
+        if (extra >= 0) {
+            extraValues[extra] = strchr(tok, '=') + 1;
+            continue;
+        }
+        if (spec[0] != '\0') {
+            strncat(spec, ";", sizeof(spec) - strlen(spec) - 1);
+        }
+        strncat(spec, tok, sizeof(spec) - strlen(spec) - 1);
+    }
+    if (spec[0] == '\0') {
+        *p = *base;
+        p->verbose = 0;
+        return 1;
+    }
+    return (parseParams(base, spec, p) == 0) ? 1 : -1;
+}
+
+int loadFacility(Instalacion *f, const SimParams *base, const char *path) {
+    memset(f, 0, sizeof(Instalacion));
+    FILE *in = fopen(path, "r");
+    if (in == NULL) {
+        perror(path);
+        return -1;
+    }
+
+    // Primero se leen todos los parámetros: los puentes van en un arreglo alineado que no se puede agrandar.
+    char line[FACILITY_LINE_SIZE];
+    char (*names)[FACILITY_NAME_SIZE] = NULL;
+    SimParams *params = NULL;
+    int count = 0;
+    int lineNumber = 0;
+    int status = 0;
+    while (status == 0 && fgets(line, sizeof(line), in) != NULL) {
+        char name[FACILITY_NAME_SIZE];
+        SimParams p;
+        lineNumber++;
+        int parsed = parseBridgeLine(line, base, name, &p, NULL, NULL);
+        if (parsed < 0) {
+            fprintf(stderr, "%s:%d: línea inválida\n", path, lineNumber);
+            status = -1;
+        } else if (parsed > 0) {
+            void *moreNames = realloc(names, (count + 1) * sizeof(*names));
+            void *moreParams = (moreNames != NULL) ? realloc(params, (count + 1) * sizeof(SimParams)) : NULL;
+            if (moreNames != NULL) {
+                names = moreNames;
+            }
+            if (moreParams == NULL) {
+                status = -1;
+                break;
+            }
+            params = moreParams;
+            memcpy(names[count], name, FACILITY_NAME_SIZE);
+            params[count] = p;
+            count++;
+        }
+    }
+    fclose(in);
+    if (status == 0 && count == 0) {
+        fprintf(stderr, "%s: no describe ningún puente\n", path);
+        status = -1;
+    }
+
+    if (status == 0 && posix_memalign((void**)&f->bridges, CACHE_LINE_SIZE, count * sizeof(FacilityBridge)) != 0) {
+        f->bridges = NULL;
+        status = -1;
+    }
+    if (status == 0) {
+        memset(f->bridges, 0, count * sizeof(FacilityBridge));
+        for (int i = 0; i < count && status == 0; i++) {
+            FacilityBridge *b = &f->bridges[i];
+            memcpy(b->name, names[i], FACILITY_NAME_SIZE);
+            if (initSimulation(&b->sim, &params[i]) != 0) {
+                fprintf(stderr, "%s: el puente %s no pudo inicializarse\n", path, b->name);
+                status = -1;
+            }
+            f->count++;         // También el que falló: freeFacility() libera lo que alcanzó a reservar.
+        }
+    }
+    free(names);
+    free(params);
+    if (status != 0) {
+        freeFacility(f);
+    }
+    return status;
+}
+
+/**************************************
+ *      *EJECUCION
+ *************************************/
+
+static int runSlice(int task, void *ctx) {
+    Instalacion *f = (Instalacion*)ctx;
+    FacilityBridge *b = &f->bridges[task];
+    int more = stepSimulation(&b->sim, FACILITY_SLICE_EVENTS);
+    ATOMIC_STORE(&b->crossed, b->sim.contador_out);
+    ATOMIC_STORE(&b->now, b->sim.now);
+    if (!more) {
+        ATOMIC_STORE(&b->done, 1);
+    }
+    return more;
+}
+
+int startFacility(Instalacion *f, int threads) {
+    return startExecutor(&f->ex, f->count, threads, runSlice, f);
+}
+
+int facilityPending(Instalacion *f) {
+    return executorPending(&f->ex);
+}
+
+void finishFacility(Instalacion *f) {
+    joinExecutor(&f->ex, &f->slices, &f->steals);
+}
+
+/**************************************
+ *      *RESULTADOS
+ *************************************/
+
+void printFacilitySummary(const Instalacion *f, FILE *out, double wallSeconds) {
+    LatencyStats total[3];
+    long long crossed = 0;
+    long long events = 0;
+    long long rejected = 0;
+    double throughput = 0;
+
+    for (int side = 1; side <= 2; side++) {
+        latencyInit(&total[side]);
+    }
+    fprintf(out, "%-16s %-10s %-7s %10s %12s %12s %12s %10s\n", "Puente", "Politica", "Modo", "Vehiculos",
+            "Tiempo_s", "Veh/s", "p99_espera_s", "Rechazos");
+    for (int i = 0; i < f->count; i++) {
+        const Simulacion *sim = &f->bridges[i].sim;
+        double seconds = simTime(sim);
+        double rate = (seconds > 0) ? sim->contador_out / seconds : 0;
+        Histogram wait;
+        histInit(&wait);
+        histMerge(&wait, &sim->latency[1].wait);
+        histMerge(&wait, &sim->latency[2].wait);
+        fprintf(out, "%-16s %-10s %-7s %10lld %12.3f %12.4f %12.3f %10lld\n", f->bridges[i].name,
+                policyName(sim->p.policy), sim->p.pipelined ? "tuberia" : "lotes", sim->contador_out, seconds,
+                rate, histPercentile(&wait, 99) / 1e6, sim->rejected[1] + sim->rejected[2]);
+
+        crossed += sim->contador_out;
+        events += sim->eventsProcessed;
+        rejected += sim->rejected[1] + sim->rejected[2];
+        throughput += rate;
+        for (int side = 1; side <= 2; side++) {
+            histMerge(&total[side].wait, &sim->latency[side].wait);
+            histMerge(&total[side].bridge, &sim->latency[side].bridge);
+            histMerge(&total[side].total, &sim->latency[side].total);
+        }
+    }
+    fprintf(out, "%-16s %-10s %-7s %10lld %12s %12.4f %12s %10lld\n", "Total", "", "", crossed, "", throughput,
+            "", rejected);
+    fprintf(out, "Instalación: %d puentes, %d hilos, %.3f s reales, %lld eventos", f->count, f->ex.count,
+            wallSeconds, events);
+    if (wallSeconds > 0) {
+        fprintf(out, " (%.0f eventos/s)", events / wallSeconds);
+    }
+    fprintf(out, "\n  Tramos: %lld, robados por otro hilo: %lld\n", f->slices, f->steals);
+    printLatencyReport(out, total);
+}
+
+void freeFacility(Instalacion *f) {
+    for (int i = 0; i < f->count; i++) {
+        freeSimulation(&f->bridges[i].sim);
+    }
+    free(f->bridges);
+    f->bridges = NULL;
+    f->count = 0;
+}
@@ -0,0 +1,136 @@
+/**
+ * @file instalacion.h
+ * @brief Varios puentes independientes, leídos de un archivo, corriendo en paralelo con robo de trabajo.
+ *
+ * @details
+ * Cada línea del archivo describe un puente: un nombre y, opcionalmente, las claves del barrido (ver
+ * barrido.h) con un solo valor cada una, separadas por ';' o espacios. Las líneas vacías y lo que sigue a '#'
+ * se ignoran. Por ejemplo:
+ *
+ *     # nombre    parámetros
+ *     norte       puente=10 cola=20 politica=ewma
+ *     sur         modo=tuberia llegada_izq=3 vehiculos=20000
+ *
+ * Cada puente es una instancia propia de Simulacion (colas, ventana, dirección, generadores y estadísticas)
+ * en su propio espacio alineado a la línea de caché, y es una tarea del ejecutor (ver ejecutor.h): un hilo
+ * corre FACILITY_SLICE_EVENTS eventos del puente, publica su avance y lo devuelve a su deque, de donde otro
+ * hilo ocioso lo puede robar. Los puentes no comparten nada, así que la instalación escala con los núcleos
+ * hasta tener un puente por hilo.
+ *
+ * @date 16 de octubre de 2026 (creación)
+ * @version 1.0
+ * @authors
+ * Julio López
+ */
+
+#ifndef INSTALACION_H
+#define INSTALACION_H
+
+#include <stdio.h>
+#include "funciones.h"
+#include "simulacion.h"
+#include "ejecutor.h"
+
+#define FACILITY_SLICE_EVENTS   4096    // Eventos por tramo de un puente
+#define FACILITY_NAME_SIZE      32
+
+/**
+ * @brief Un puente de la instalación.
+ *
+ * El avance publicado va en una línea de caché aparte, así quien lo muestra no molesta al hilo que corre la
+ * simulación.
+ */
+typedef struct {
+    ATOMIC_LLONG crossed;               /**< Vehículos que cruzaron, al final del último tramo */
+    ATOMIC_LLONG now;                   /**< Reloj virtual al final del último tramo (us) */
+    ATOMIC_INT done;                    /**< 1 cuando el puente terminó */
+    char pad[CACHE_LINE_SIZE - 2 * sizeof(ATOMIC_LLONG) - sizeof(ATOMIC_INT)];
+    char name[FACILITY_NAME_SIZE];      /**< Nombre del puente en el archivo */
+    Simulacion sim;                     /**< Estado propio; solo lo toca el hilo que corre el tramo */
+} __attribute__((aligned(CACHE_LINE_SIZE))) FacilityBridge;
+
+/**
+ * @brief La instalación completa.
+ */
+typedef struct {
+    FacilityBridge *bridges;    /**< Puentes, en el orden del archivo */
+    int count;                  /**< Cantidad de puentes */
+    Executor ex;                /**< Hilos que corren los puentes */
+    long long slices;           /**< Tramos corridos, al terminar */
+    long long steals;           /**< Tramos robados por otro hilo, al terminar */
+} Instalacion;
+
+
+/**
+ * @brief Lee una línea del archivo: el nombre, los parámetros y, si se piden, claves propias de quien llama.
+ *
+ * @param line Línea a leer; se modifica y los valores de extraValues apuntan dentro de ella
+ * @param base Parámetros de partida
+ * @param name Donde se guarda el nombre, al menos FACILITY_NAME_SIZE caracteres
+ * @param p Donde se guardan los parámetros
+ * @param extraKeys Claves que no son del barrido, terminadas en NULL (NULL: ninguna)
+ * @param extraValues Valor de cada clave de extraKeys, o NULL si la línea no la tiene
+ * @return int 1 si la línea describe un puente, 0 si está vacía, -1 si es inválida
+ */
+int parseBridgeLine(char *line, const SimParams *base, char *name, SimParams *p, const char *const *extraKeys,
+                    char **extraValues);
+
+
+/**
+ * @brief Lee el archivo e inicializa una simulación por puente.
+ *
+ * @param f Instalación a inicializar
+ * @param base Parámetros de partida de todos los puentes
+ * @param path Ruta del archivo
+ * @return 0 si todo salió bien, -1 si no se pudo leer, es inválido (el error se informa en stderr) o no hubo
+ * memoria
+ */
+int loadFacility(Instalacion *f, const SimParams *base, const char *path);
+
+
+/**
+ * @brief Pone a correr todos los puentes.
+ *
+ * @param f Instalación cargada
+ * @param threads Hilos a usar (0 o menos: uno por procesador)
+ * @return 0 si todo salió bien, -1 si no se pudo crear el ejecutor
+ */
+int startFacility(Instalacion *f, int threads);
+
+
+/**
+ * @brief Puentes que todavía no terminaron. Se puede consultar mientras la instalación corre.
+ *
+ * @param f Instalación
+ * @return int
+ */
+int facilityPending(Instalacion *f);
+
+
+/**
+ * @brief Espera a que terminen todos los puentes.
+ *
+ * @param f Instalación en marcha
+ */
+void finishFacility(Instalacion *f);
+
+
+/**
+ * @brief Imprime una fila por puente, los totales y las latencias de todos los puentes juntos.
+ *
+ * @param f Instalación terminada
+ * @param out Archivo de salida
+ * @param wallSeconds Tiempo real que tomó la corrida
+ */
+void printFacilitySummary(const Instalacion *f, FILE *out, double wallSeconds);
+
+
+/**
+ * @brief Libera la memoria de la instalación.
+ *
+ * @param f Instalación
+ */
+void freeFacility(Instalacion *f);
+
+
+#endif
@@ -33,184 +33,1207 @@
  * Hector Cepeda
  */
 
+#include <errno.h>
+#include <limits.h>
 #include <string.h>
 #include <time.h>
 #include <curses.h>
 #include "funciones.h"
+#include "simulacion.h"
+#include "estadisticas.h"
+#include "barrido.h"
+#include "traza.h"
+#include "instalacion.h"
+#include "red.h"
+#include "metricas.h"
+#include "alimentacion.h"
+#include "respaldo.h"
+#include "control.h"
 
 //Constantes
 #define BUFFER_SIZE         20
 #define PARKING_SIZE        10
 #define WINDOW_SIZE         3
 #define PARKING_SPEED       250000
+#define MAX_VEHICLES        50
+#define TIMER_TICK_US       1000    // Resolución de la rueda de llegadas
+#define FACILITY_REFRESH_US 100000  // Cada cuánto se redibuja el avance de la instalación
+#define STATS_INTERVAL      1       // Segundos entre líneas de estadísticas por defecto (-I)
 
-// Para el manejo de mensajes con un buffer
-static char* messageBuffer[MESSAGE_BUFFER_SIZE];
-static int messageIndex = 0;
-static int messageCount = 0;
-void initMessageBuffer();
-void freeMessageBuffer();
+// Opciones de la línea de comandos
+static long long maxVehicles = MAX_VEHICLES;
+static int headless = 0;
+static int verbose = 0;
+static int renderFps = 0;       // 0: se dibuja en cada evento desde el hilo que lo genera
+static int incremental = 0;     // 1: se redibujan solo las celdas que cambiaron
+static const char *sweepSpec = NULL;
+static const char *sweepOutput = NULL;
+static int sweepThreads = 0;    // 0: un hilo por procesador
+static PolicyKind policy = POLICY_ALTERNATE;    // Siempre cambia de lado, como el programa original
+static int comparePolicies = 0;
+static int pipelined = 0;
+static int bulk = 0;            // 1: el lote sale de la cola en una sola sección crítica
+static double priorityPercent = 0;      // Porcentaje de llegadas que son vehículos de emergencia
+static unsigned long long seed = 1;     // 0: se elige a partir del reloj
+static ArrivalKind arrival = ARRIVAL_UNIFORM;
+static int gates = 1;
+static const char *facilityPath = NULL;     // Con -B se corren varios puentes leídos del archivo
+static const char *networkPath = NULL;      // Con -R se corre una red de tramos leída del archivo
+static double networkHorizon = NETWORK_HORIZON;
+static const char *tracePath = NULL;    // Con -T se guarda la traza en vez de dibujar
+static TraceFile traceFile;
+static const char *metricsName = NULL;  // Con -M se publican las métricas en memoria compartida
+static MetricsExport metrics;
+static ATOMIC_INT metricsRunning = 0;
+static const char *feedName = NULL;     // Con -A las llegadas las envían procesos alimentadores
+static Alimentacion feed;
+static int feedSides[3] = {0, 1, 2};
+static const char *checkpointPath = NULL;   // Con -K la simulación guarda puntos de control
+static double checkpointInterval = CHECKPOINT_INTERVAL;
+static CheckpointWriter checkpointWriter;
+static const char *restorePath = NULL;      // Con -L la simulación sigue desde un punto de control
+static double maxDuration = 0;      // Con -D, segundos de la corrida después de los cuales no empieza otro lote
+static double wallLimit = 0;        // Con -W, segundos de tiempo real después de los cuales se cancela
+static const char *statsPath = NULL;        // Con -J se escribe una línea JSON de estadísticas cada -I segundos
+static double statsInterval = STATS_INTERVAL;
+static FILE *statsOut = NULL;
+static MetricsSnapshot statsPrev;           // Foto de la línea anterior, para el throughput del intervalo
+static long long statsLines = 0;
+static int givenOptions = 0;    // Opciones GIVEN_* escritas en la línea de comandos: al retomar, reemplazan
+
+#define GIVEN_VEHICLES  1
+#define GIVEN_POLICY    2
+#define GIVEN_PRIORITY  4
+#define GIVEN_SEED      8
+#define GIVEN_DURATION  16
+static int runHeadless();
+static int runParameterSweep();
+static int runFacility();
+static int runNetworkFile();
+static void* metricsLoop(void* arg);
+static void* feedIntake(void* arg);
+static void* statsLoop(void* arg);
+static void snapshotThreaded(MetricsSnapshot *snap);
+static void publishLatency(Estacionamiento *e);
+static void publishThreaded();
+static void writeStats(const MetricsSnapshot *snap, int virtualTime);
+
+static ATOMIC_INT renderRunning = 0;
+
+// Historial de los últimos eventos; el texto se arma recién al dibujar
+static MessageRing messageRing;
 
 
 // Esta variable global almacenará el tiempo de inicio
 struct timespec start_time;
 
-/* Colas de espera */
-CircularBuffer *leftBuffer, *rightBuffer, *parkingBuffer;
+/* Instancia que se muestra en pantalla */
+static Estacionamiento *est;
 
-/* Semáforos */
-sem_t leftSemaphore, rightSemaphore, parkingSemaphore, windowSem;
+/* Resumen de las latencias que el hilo del puente publica entre lotes (seqlock); los hilos de -M y -J leen esta
+   copia en vez de los histogramas, que el puente actualiza sin sincronizar */
+typedef struct {
+    ATOMIC_INT seq;             // Impar mientras el puente escribe
+    MetricsLatency wait[3];
+    MetricsLatency total[3];
+} PublishedLatency;
+static PublishedLatency publishedLatency;
 
 /* Mutex para printear */
 pthread_mutex_t printMutex;
 
-/* Contadores*/
-ATOMIC_INT contador_in = 0;
-ATOMIC_INT contador_out = 0;                                                                                                                                                       ATOMIC_INT window = WINDOW_SIZE;
-int dir;
+/* Fin de la corrida con hilos: my_sleep() y sleep_until_us() esperan en stopCond para despertar apenas se pide */
+static ATOMIC_INT stopping = 0;
+static pthread_mutex_t stopMutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t stopCond;
+static pthread_once_t stopOnce = PTHREAD_ONCE_INIT;
+
+static void initStopCond() {
+    pthread_condattr_t attr;
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);     // Los plazos son del mismo reloj que start_time.
+    pthread_cond_init(&stopCond, &attr);
+    pthread_condattr_destroy(&attr);
+}
+
+/**
+ * @brief Pide que terminen todos los hilos de la corrida: los productores y el puente lo ven en contador_in,
+ * y los que duermen despiertan. La llaman el puente al llegar a un límite y el hilo de control.
+ */
+static void requestStop(Estacionamiento *e) {
+    pthread_once(&stopOnce, initStopCond);
+    pthread_mutex_lock(&stopMutex);
+    ATOMIC_STORE(&e->contador_in, 1);
+    ATOMIC_STORE(&stopping, 1);
+    pthread_cond_broadcast(&stopCond);
+    pthread_mutex_unlock(&stopMutex);
+}
+
+// Saca el próximo vehículo de un lado, primero del carril de emergencias salvo que ya salieron PRIORITY_BURST
+// seguidas y espera un vehículo común. Se llama con el bloqueo de la cola y después de reservar un vehículo del
+// lado con waitVehicle() o tryVehicle(). Solo el puente retira, así que una cola con vehículos no se vacía
+// mientras se decide.
+static int takeVehicle(Estacionamiento *e, int side) {
+    WaitQueue *queue = (side == 1) ? e->leftBuffer : e->rightBuffer;
+    if (ATOMIC_LOAD(&e->priorityWaiting[side]) > 0 &&
+        (e->priorityStreak[side] < PRIORITY_BURST || queueCount(queue) == 0)) {
+        e->priorityStreak[side]++;
+        ATOMIC_ADD(&e->priorityWaiting[side], -1);
+        return queueRemove((side == 1) ? e->leftPriority : e->rightPriority);
+    }
+    e->priorityStreak[side] = 0;
+    return queueRemove(queue);
+}
+
+/**
+ * @brief Punto seguro del lote, antes de admitir otro vehículo: si espera una emergencia del lado contrario y
+ * ya no quedan del lado que tiene el paso, el lote se corta y el puente se vacía para cambiar de dirección.
+ * Un lote que todavía no admitió a nadie no se corta, así cada turno de un lado avanza al menos un vehículo.
+ *
+ * @param admitted Vehículos que ya admitió el lote
+ * @return 1 si el lote se corta
+ */
+static int preempted(Estacionamiento *e, int admitted) {
+    if (admitted > 0 && (e->dir == 1 || e->dir == 2) && ATOMIC_LOAD(&e->priorityWaiting[e->dir]) == 0 &&
+        ATOMIC_LOAD(&e->priorityWaiting[3 - e->dir]) > 0) {
+        COUNTER_INC(&e->preemptions);
+        printState('!', 0);
+        return 1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Un lote del puente en modo tubería.
+ *
+ * Cada PARKING_SPEED el puente avanza un espacio con shiftBuffer(): si hay un vehículo esperando del lado que
+ * tiene el paso entra por un extremo mientras el más antiguo sale por el otro, así los vehículos del lote
+ * avanzan solos y el lote puede ser más largo que el puente. La admisión se cierra al completar la ventana o
+ * cuando nadie llega a la cola en admitTimeout (como en el modo por lotes), y el lote termina cuando sale el
+ * último vehículo.
+ */
+static void crossPipelined(Estacionamiento *e) {
+    int half_time = (int)(e->p.parkingSpeed / 2);
+    int admitted = 0;
+    int open = (e->dir == 1 || e->dir == 2);
+    sem_t *lock = (e->dir == 1) ? &e->leftSemaphore : &e->rightSemaphore;
+    sem_t *items = (e->dir == 1) ? &e->leftItems : &e->rightItems;
+
+    while ((open || !isBufferEmpty(e->parkingBuffer)) && !ATOMIC_LOAD(&e->contador_in)) {
+        int entering = 0;
+        if (open && admitted < ATOMIC_LOAD(&e->window) && !preempted(e, admitted) &&
+            waitVehicle(items, e->p.admitTimeout)) {
+            QUEUE_LOCK(lock);
+            my_sleep(half_time);                    // Saliendo de la cola
+            entering = takeVehicle(e, e->dir);
+            recordDequeue(e->vehicles, e->latency, e->priorityLatency, entering, get_time_us());
+            printState((e->dir == 1) ? 'a' : 'b', entering);
+            QUEUE_UNLOCK(lock);
+            my_sleep(half_time);                    // Entrando mientras el puente avanza
+            admitted++;
+        } else {
+            open = 0;                               // Ventana completa, nadie llegó o emergencia: se cierra.
+            my_sleep(e->p.parkingSpeed);
+        }
+
+        int value = shiftBuffer(e->parkingBuffer, entering);
+        if (value > 0) {
+            recordCrossing(e->vehicles, e->latency, e->priorityLatency, value, get_time_us());
+            COUNTER_INC(&e->contador_out);          // contador_out++
+        }
+        if (value > 0 || !entering) {
+            printState('O', value);
+        }
+        if (entering) {
+            printState((e->dir == 1) ? 'A' : 'B', entering);
+        }
+    }
+}
+
+/**
+ * @brief Entrada de un lote que sale de la cola en una sola sección crítica (-b).
+ *
+ * Se reservan de una vez los vehículos de la ventana que ya esperan (a lo sumo admitTimeout por el primero),
+ * se retiran juntos con queueRemoveMany(), primero los del carril de emergencias (a lo sumo PRIORITY_BURST
+ * seguidas si espera un vehículo común), y después entran al puente uno por paso, como en el modo por lotes.
+ * Los que llegan mientras el lote entra esperan al siguiente. Si espera una emergencia del otro lado, entra uno
+ * solo y el lote se corta.
+ */
+static void enterBulk(Estacionamiento *e) {
+    if (e->dir != 1 && e->dir != 2) {
+        return;
+    }
+    WaitQueue *queue = (e->dir == 1) ? e->leftBuffer : e->rightBuffer;
+    WaitQueue *lane = (e->dir == 1) ? e->leftPriority : e->rightPriority;
+    sem_t *lock = (e->dir == 1) ? &e->leftSemaphore : &e->rightSemaphore;
+    sem_t *items = (e->dir == 1) ? &e->leftItems : &e->rightItems;
+    int window = ATOMIC_LOAD(&e->window);
+    if (window > e->p.bufferSize) {
+        window = e->p.bufferSize;       // Nunca hay más que una cola llena.
+    }
+    if (window > 1 && preempted(e, 1)) {
+        window = 1;
+    }
+    int ids[window > 0 ? window : 1];
+    int reserved = 0;
+    if (window > 0 && waitVehicle(items, e->p.admitTimeout)) {
+        reserved = 1;
+        while (reserved < window && tryVehicle(items)) {
+            reserved++;
+        }
+    }
+    if (reserved == 0) {
+        return;
+    }
+
+    QUEUE_LOCK(lock);
+    my_sleep(e->p.parkingSpeed / 2);            // Saliendo de la cola
+    int urgent = ATOMIC_LOAD(&e->priorityWaiting[e->dir]);
+    int burst = PRIORITY_BURST - e->priorityStreak[e->dir];
+    if (urgent > burst && queueCount(queue) > 0) {
+        urgent = (burst > 0) ? burst : 0;       // Pasa antes un vehículo común.
+    }
+    int first = queueRemoveMany(lane, ids, (urgent < reserved) ? urgent : reserved);
+    int common = queueRemoveMany(queue, ids + first, reserved - first);
+    int rest = queueRemoveMany(lane, ids + first + common, reserved - first - common);
+    ATOMIC_ADD(&e->priorityWaiting[e->dir], -(first + rest));
+    e->priorityStreak[e->dir] = (common > 0) ? rest : e->priorityStreak[e->dir] + first + rest;
+    int taken = first + common + rest;
+    QUEUE_UNLOCK(lock);
+    long long now = get_time_us();
+    for (int i = 0; i < taken; i++) {
+        recordDequeue(e->vehicles, e->latency, e->priorityLatency, ids[i], now);
+        printState((e->dir == 1) ? 'a' : 'b', ids[i]);
+    }
+    for (int i = 0; i < taken; i++) {
+        my_sleep((i == 0) ? e->p.parkingSpeed / 2 : e->p.parkingSpeed);     // Entrando al estacionamiento
+        addToBuffer(e->parkingBuffer, ids[i]);
+        rotateBuffer(e->parkingBuffer);
+        printState((e->dir == 1) ? 'A' : 'B', ids[i]);
+    }
+}
 
 void* recorrerEstacionamiento(void* arg) {
+    Estacionamiento *e = (Estacionamiento*)arg;
     int value;
-    int half_time = (int)(PARKING_SPEED / 2);
-    my_sleep(3*PARKING_SPEED);
-    while(ATOMIC_LOAD(&contador_out) <= 50) {
-        sem_wait(&parkingSemaphore);   // ! Esperar a que el estacionamiento esté disponible.
-
-        //? ENTRADA AL ESTACIONAMIENTO *//
-        for (int i = 0; i < ATOMIC_LOAD(&window); i++) {
-            //* LADO IZQUIERDO *//
-            if((dir == 1)) {
-                sem_wait(&leftSemaphore);               // ? Se pausa leftSemaphore
-                my_sleep(half_time);                    // Saliendo de la cola
-                value = removeFromBuffer(leftBuffer);   // Sale de la cola.
-                printState('a', value);
-                sem_post(&leftSemaphore);               // ? Se libera leftSemaphore
-                my_sleep(half_time);                    // Entrando al estacionamiento
-                addToBuffer(parkingBuffer, value);      // Entra al estacionamiento.
-                parkingBuffer->tail = (parkingBuffer->tail + 1) % (parkingBuffer->size);
-                printState('A', value);
+    int half_time = (int)(e->p.parkingSpeed / 2);
+    PROFILED_THREAD("puente");
+    my_sleep(3*e->p.parkingSpeed);
+    // Como en la simulación, -n y -D se revisan entre lotes; una cancelación corta también el lote en curso.
+    while(ATOMIC_LOAD(&e->contador_out) <= e->p.maxVehicles && !ATOMIC_LOAD(&e->contador_in) &&
+          (e->p.maxDuration == 0 || get_time_us() < e->p.maxDuration)) {
+        PROFILED_SEM_WAIT(&e->parkingSemaphore);     // ! Esperar a que el estacionamiento esté disponible.
+
+        if (e->p.pipelined) {
+            crossPipelined(e);
+        } else {
+            //? ENTRADA AL ESTACIONAMIENTO *//
+            if (e->p.bulk) {
+                enterBulk(e);
+            } else {
+                for (int i = 0; i < ATOMIC_LOAD(&e->window); i++) {
+                    if (ATOMIC_LOAD(&e->contador_in) || preempted(e, i)) {
+                        break;                                  // Cancelada o emergencia del otro lado.
+                    }
+
+                    //* LADO IZQUIERDO *//
+                    if((e->dir == 1)) {
+                        if (!waitVehicle(&e->leftItems, e->p.admitTimeout)) {
+                            break;                              // La cola se vació: se libera el puente antes.
+                        }
+                        QUEUE_LOCK(&e->leftSemaphore);          // ? Se pausa leftSemaphore
+                        my_sleep(half_time);                    // Saliendo de la cola
+                        value = takeVehicle(e, 1);              // Sale de la cola.
+                        recordDequeue(e->vehicles, e->latency, e->priorityLatency, value, get_time_us());
+                        printState('a', value);
+                        QUEUE_UNLOCK(&e->leftSemaphore);        // ? Se libera leftSemaphore
+                        my_sleep(half_time);                    // Entrando al estacionamiento
+                        addToBuffer(e->parkingBuffer, value);   // Entra al estacionamiento.
+                        rotateBuffer(e->parkingBuffer);
+                        printState('A', value);
+                    }
+
+                    //* LADO DERECHO *//
+                    else if((e->dir == 2)) {
+                        if (!waitVehicle(&e->rightItems, e->p.admitTimeout)) {
+                            break;                              // La cola se vació: se libera el puente antes.
+                        }
+                        QUEUE_LOCK(&e->rightSemaphore);         // ? Se pausa rightSemaphore
+                        my_sleep(half_time);                    // Saliendo de la cola
+                        value = takeVehicle(e, 2);              // Sale alguien de la cola.
+                        recordDequeue(e->vehicles, e->latency, e->priorityLatency, value, get_time_us());
+                        printState('b', value);
+                        QUEUE_UNLOCK(&e->rightSemaphore);       // ? Se libera rightSemaphore
+                        my_sleep(half_time);
+                        addToBuffer(e->parkingBuffer, value);   // Entra al estacionamiento.
+                        rotateBuffer(e->parkingBuffer);
+                        printState('B', value);
+                    }
+                }
             }
 
-            //* LADO DERECHO *//
-            else if((dir == 2)) {
-                sem_wait(&rightSemaphore);              // ? Se pausa rightSemaphore
-                my_sleep(half_time);                    // Saliendo de la cola
-                value = removeFromBuffer(rightBuffer);  // Sale alguien de la cola.
-                printState('b', value);
-                sem_post(&rightSemaphore);              // ? Se libera rightSemaphore
-                my_sleep(half_time);
-                addToBuffer(parkingBuffer, value);      // Entra al estacionamiento.
-                parkingBuffer->tail = (parkingBuffer->tail + 1) % (parkingBuffer->size);
-                printState('B', value);
+            //? AVANZAR EN EL ESTACIONAMIENTO *//
+            // Vaciar el buffer del estacionamiento.
+            while(!isBufferEmpty(e->parkingBuffer) && !ATOMIC_LOAD(&e->contador_in)) {
+                my_sleep(e->p.parkingSpeed);                // Vehiculo moviéndose/saliendo del estacionamiento.
+                value = removeFromBuffer(e->parkingBuffer);
+                if (value > 0) {
+                    recordCrossing(e->vehicles, e->latency, e->priorityLatency, value, get_time_us());
+                    COUNTER_INC(&e->contador_out);          // contador_out++
+                }
+                printState('O', value);
             }
         }
 
-        //? AVANZAR EN EL ESTACIONAMIENTO *//
-        // Vaciar el buffer del estacionamiento.
-        while(!isBufferEmpty(parkingBuffer)) {
-            my_sleep(PARKING_SPEED);                    // Vehiculo moviéndose/saliendo del estacionamiento.
-            value = removeFromBuffer(parkingBuffer);
-            printState('O', value);
+        if (statsReportRequested) {
+            statsReportRequested = 0;
+            printLatencyReport(stderr, e->latency);
+            printPriorityReport(stderr, e->priorityLatency);
         }
+        publishLatency(e);
 
-        //? CAMBIAR SENTIDO DEL TRAFICO *//
-        dir = (dir == 1) ? 2 : 1;       // 1 es izquierda, 2 es derecha
-        updateWindowSize(leftBuffer, rightBuffer);
+        //? ELEGIR SENTIDO DEL TRAFICO Y VENTANA *//
+        nextBatch(e);                       // 1 es izquierda, 2 es derecha
 
-        sem_post(&parkingSemaphore);    // ! Liberar el estacionamiento.
+        PROFILED_SEM_POST(&e->parkingSemaphore);     // ! Liberar el estacionamiento.
     }
-    ATOMIC_STORE(&contador_in, 1);
+    publishLatency(e);      // Lo que cruzó en un lote cortado por la cancelación.
+    requestStop(e);
     return NULL;
 }
 
-void* newVehiculo(void* arg) {
-    int bufferId = *((int*)arg);
-    int waitingTime;
-    while(1) {
-        if(ATOMIC_LOAD(&contador_in) == 1) {break;}
-        //* LADO IZQUIERDO *//
-        if(bufferId == 1) {
-            waitingTime = ((2*PARKING_SPEED)+ rand() % (7*PARKING_SPEED));
-            my_sleep(waitingTime);
-            sem_wait(&leftSemaphore);       // Se pausa el semáforo. (P)
-            addToBuffer(leftBuffer, 1);     // Se añade vehiculo al buffer.      
-            printState('l', -1);
-            sem_post(&leftSemaphore);       // Se libera el semáforo. (V)
+// Llega un vehículo a la cola del lado "side", o a su carril de emergencias si "priority" es 1.
+static void arriveVehicle(Estacionamiento *e, int side, int priority) {
+    int id = prepareVehicle(&e->vehicles[side], get_time_us());
+    COUNTER_INC(&e->sides[side].arrivals);
+    vehicleTimes(&e->vehicles[side], id)->priority = priority;
+
+    //* LADO IZQUIERDO *//
+    if(side == 1) {
+        QUEUE_LOCK(&e->leftSemaphore);      // Se pausa el semáforo. (P)
+        if (queueAdd(priority ? e->leftPriority : e->leftBuffer, id)) {    // Se añade vehiculo al buffer.
+            commitVehicle(&e->vehicles[1]);
+            ATOMIC_ADD(&e->priorityWaiting[1], priority);
+            sem_post(&e->leftItems);        // Disponible para el puente.
+            printState('l', id);
+        } else {
+            COUNTER_INC(&e->sides[1].rejected);
+            printState('L', id);            // Cola llena, el vehículo no espera.
         }
+        QUEUE_UNLOCK(&e->leftSemaphore);    // Se libera el semáforo. (V)
+    }
 
-        //* LADO DERECHO *//
-        else if(bufferId == 2) {
-            waitingTime = ((2*PARKING_SPEED) + rand() % (5*PARKING_SPEED));
-            my_sleep(waitingTime);
-            sem_wait(&rightSemaphore);      // Se pausa el semáforo. (P)
-            addToBuffer(rightBuffer, 1);    // Se añade vehiculo al buffer.
-            printState('r', -1);
-            sem_post(&rightSemaphore);      // Se libera el semáforo. (V)
+    //* LADO DERECHO *//
+    else if(side == 2) {
+        QUEUE_LOCK(&e->rightSemaphore);     // Se pausa el semáforo. (P)
+        if (queueAdd(priority ? e->rightPriority : e->rightBuffer, id)) {  // Se añade vehiculo al buffer.
+            commitVehicle(&e->vehicles[2]);
+            ATOMIC_ADD(&e->priorityWaiting[2], priority);
+            sem_post(&e->rightItems);       // Disponible para el puente.
+            printState('r', id);
+        } else {
+            COUNTER_INC(&e->sides[2].rejected);
+            printState('R', id);            // Cola llena, el vehículo no espera.
         }
+        QUEUE_UNLOCK(&e->rightSemaphore);   // Se libera el semáforo. (V)
+    }
+}
+
+// Agenda la próxima llegada de una fuente. Con varias puertas por lado cada una espera "gates" veces más,
+// así el lado recibe en total la misma tasa. "phase" acorta la primera espera (ver arrivalScheduler()).
+static void scheduleSource(TimerWheel *wheel, Productor *src, double phase) {
+    Estacionamiento *e = src->est;
+    long long gap = arrivalGap(&src->rng, e->p.arrival, e->p.arrivalMin[src->side], e->p.arrivalSpread[src->side]);
+    src->deadline += (long long)(gap * e->p.gates * phase);
+    src->node.tick = src->deadline / TIMER_TICK_US;
+    timerAdd(wheel, &src->node);
+}
+
+static void fireArrival(TimerNode *node, void *ctx) {
+    Productor *src = (Productor*)node->owner;
+    Estacionamiento *e = src->est;
+    // La clase sale del mismo generador de la puerta; sin emergencias no se sortea y las llegadas no cambian.
+    arriveVehicle(e, src->side, e->p.priorityShare > 0 && randomUnit(&src->rng) < e->p.priorityShare);
+    scheduleSource((TimerWheel*)ctx, src, 1.0);
+}
+
+void* arrivalScheduler(void* arg) {
+    Estacionamiento *e = (Estacionamiento*)arg;
+    int count = 2 * e->p.gates;
+    PROFILED_THREAD("llegadas");
+    Productor *sources = calloc(count, sizeof(Productor));
+    TimerWheel wheel;
+    if (sources == NULL) {
+        return NULL;
+    }
+
+    long long now = get_time_us();
+    initTimerWheel(&wheel, now / TIMER_TICK_US);
+    for (int i = 0; i < count; i++) {
+        Productor *src = &sources[i];
+        src->est = e;
+        src->side = 1 + i % 2;
+        seedRng(&src->rng, e->p.seed, i + 1);
+        src->deadline = now;
+        src->node.owner = src;
+        // Con varias puertas cada una empieza en un punto al azar de su primera espera; si no, ninguna
+        // llegaría antes de gates * arrivalMin.
+        scheduleSource(&wheel, src, (e->p.gates > 1) ? randomUnit(&src->rng) : 1.0);
     }
+
+    while (ATOMIC_LOAD(&e->contador_in) != 1) {
+        // Plazo absoluto: el tiempo de atender las llegadas no atrasa las siguientes.
+        sleep_until_us(timerNextTick(&wheel) * TIMER_TICK_US);
+        if (ATOMIC_LOAD(&e->contador_in) == 1) {
+            break;
+        }
+        advanceTimerWheel(&wheel, get_time_us() / TIMER_TICK_US, fireArrival, &wheel);
+    }
+    free(sources);
     return NULL;
 }
 
-int main() {
-    // Inicializar ncurses
-    initscr();
-    cbreak();
-    noecho();
-    curs_set(FALSE);
-
-    // Inicializar el buffer de mensajes
-    initMessageBuffer();
-
-    // Inicializar variables globales
-    dir = 0;
-    pthread_t leftIn, rightIn, puente;
-    int left_id  = 1;
-    int right_id  = 2;
-
-    // Inicializar buffers
-    leftBuffer = createBuffer(BUFFER_SIZE);         // Cola de espera izquierda
-    rightBuffer = createBuffer(BUFFER_SIZE);        // Cola de espera derecha
-    parkingBuffer = createBuffer(PARKING_SIZE);     // Capacidad del estacionamiento
-
-    // Llenado inicial de las colas
-    int initial_left_amount = 4 + rand() % 3;
-    for (int i = 0; i < initial_left_amount; i++)
-        addToBuffer(leftBuffer, 1);
-    int initial_right_amount = 4 + rand() % 3;
-    for (int i = 0; i < initial_right_amount; i++)
-        addToBuffer(rightBuffer, 1);
-
-    // Inicializar semáforos y mutex
-    sem_init(&leftSemaphore, 0, 1);
-    sem_init(&rightSemaphore, 0, 1);
-    sem_init(&parkingSemaphore, 0, 1);
+/**
+ * @brief Entrega a la cola de un lado las llegadas que envían los alimentadores (-A).
+ *
+ * Reemplaza a arrivalScheduler(): hay un hilo por lado, así cada cola sigue teniendo un único productor.
+ */
+static void* feedIntake(void* arg) {
+    int side = *(int*)arg;
+    FeedRecord record;
+    PROFILED_THREAD((side == 1) ? "entrada_izq" : "entrada_der");
+    while (ATOMIC_LOAD(&est->contador_in) != 1) {
+        if (!waitVehicle(&feed.segment->rings[side].items, FEED_POLL_US)) {
+            continue;       // Sin alimentadores: se revisa si la corrida terminó.
+        }
+        // Un alimentador publica antes de avisar, pero otro que reservó antes puede seguir escribiendo. Si
+        // tarda, se espera durmiendo; si murió antes de publicar, el espacio se salta en vez de esperarlo.
+        long long since = get_time_us();
+        while (!feedPop(&feed, side, &record)) {
+            if (ATOMIC_LOAD(&est->contador_in) == 1) {
+                return NULL;
+            }
+            long long waited = get_time_us() - since;
+            if (waited >= FEED_STALL_US) {
+                feedReclaim(&feed, side);
+                since = get_time_us();
+            } else if (waited < FEED_SPIN_US) {
+                sched_yield();
+            } else {
+                my_sleep(FEED_SPIN_US);
+            }
+        }
+        arriveVehicle(est, side, record.priority != 0);
+    }
+    return NULL;
+}
+
+/**
+ * @brief Parámetros por defecto, tomados de las constantes de este archivo.
+ */
+static void defaultParams(SimParams *params) {
+    params->bufferSize = BUFFER_SIZE;
+    params->parkingSize = PARKING_SIZE;
+    params->windowSize = WINDOW_SIZE;
+    params->parkingSpeed = PARKING_SPEED;
+    params->arrivalMin[1] = 2 * PARKING_SPEED;
+    params->arrivalSpread[1] = 7 * PARKING_SPEED;
+    params->arrivalMin[2] = 2 * PARKING_SPEED;
+    params->arrivalSpread[2] = 5 * PARKING_SPEED;
+    params->arrival = arrival;
+    params->gates = gates;
+    params->weights.focusWeight = 4;
+    params->weights.otherWeight = 1;
+    params->weights.divisor = 1;
+    // En tubería el lote no está limitado por la capacidad del puente, sino por la cola.
+    params->weights.maxWindow = pipelined ? BUFFER_SIZE : PARKING_SIZE;
+    params->policy = policy;
+    params->admitTimeout = PARKING_SPEED / 2;     // Lo que tarda un vehículo en salir de la cola.
+    params->pipelined = pipelined;
+    params->bulk = bulk;
+    params->priorityShare = priorityPercent / 100.0;
+    params->maxVehicles = maxVehicles;
+    params->maxDuration = (long long)(maxDuration * 1000000);
+    params->seed = seed;
+    params->verbose = verbose;
+}
+
+static void usage(const char *prog) {
+    fprintf(stderr, "Uso: %s [-s] [-n vehiculos] [-v] [-f fps] [-i] [-T archivo] [-t] [-b] [-P politica]\n"
+                    "       [-r semilla] [-d distribucion] [-g puertas] [-S barrido | -C | -B archivo | -R archivo]\n"
+                    "       [-H segundos] [-o archivo] [-j hilos] [-M nombre] [-A nombre] [-E porcentaje]\n"
+                    "       [-K archivo] [-k segundos] [-L archivo] [-D segundos] [-W segundos] [-J archivo]\n"
+                    "       [-I segundos]\n", prog);
+    fprintf(stderr, "  -s            Simulación de eventos discretos sin pantalla (tiempo virtual)\n");
+    fprintf(stderr, "  -n vehiculos  Termina cuando cruzan más de esta cantidad (por defecto %d)\n", MAX_VEHICLES);
+    fprintf(stderr, "  -D segundos   No empieza otro lote después de estos segundos de corrida (virtuales con -s);\n");
+    fprintf(stderr, "                sin -n, este es el único límite\n");
+    fprintf(stderr, "  -W segundos   Cancela la corrida después de estos segundos de tiempo real, igual que Ctrl-C:\n");
+    fprintf(stderr, "                con reporte final (y punto de control con -K); sin -n no hay otro límite\n");
+    fprintf(stderr, "  -v            Con -s, imprime cada evento\n");
+    fprintf(stderr, "  -f fps        Dibuja la pantalla desde un hilo propio a esta tasa de cuadros\n");
+    fprintf(stderr, "  -i            Redibuja solo lo que cambió, sin limpiar la pantalla\n");
+    fprintf(stderr, "  -T archivo    Sin pantalla: guarda cada evento en una traza binaria (ver reproducir).\n");
+    fprintf(stderr, "                Con -s la traza usa el tiempo virtual\n");
+    fprintf(stderr, "  -t            Puente en modo tubería: entran y salen vehículos en el mismo paso\n");
+    fprintf(stderr, "  -b            Por lotes con hilos: el lote sale de la cola tomando el bloqueo una sola vez\n");
+    fprintf(stderr, "  -P politica   Dirección y ventana de cada lote: alternar (por defecto, siempre cambia de\n");
+    fprintf(stderr, "                lado), heuristica, presion, antiguo, ewma\n");
+    fprintf(stderr, "  -r semilla    Semilla de las llegadas (por defecto 1, 0: a partir del reloj); la misma semilla\n");
+    fprintf(stderr, "                repite las mismas llegadas\n");
+    fprintf(stderr, "  -d distrib    Espera entre llegadas: uniforme (por defecto), exponencial, rafagas\n");
+    fprintf(stderr, "  -g puertas    Fuentes de llegada por lado (por defecto 1), repartiendo la misma tasa;\n");
+    fprintf(stderr, "                todas las atiende un solo hilo\n");
+    fprintf(stderr, "  -S barrido    Corre en paralelo todas las combinaciones, ej. \"peso=2,4;puente=5,10\"\n");
+    fprintf(stderr, "                Claves: peso, peso_contrario, divisor, ventana_max, puente, cola, velocidad,\n");
+    fprintf(stderr, "                llegada_izq, llegada_der (estas dos en múltiplos de la velocidad), semilla, puertas\n");
+    fprintf(stderr, "                También acepta politica=nombre,... o politica=todas, modo=lotes,tuberia\n");
+    fprintf(stderr, "                y distribucion=uniforme,exponencial,rafagas\n");
+    fprintf(stderr, "                puente y cola admiten hasta %d espacios (make RING_CAPACITY=n para más),\n",
+            INT_RING_CAPACITY);
+    fprintf(stderr, "                igual que en -B y -R\n");
+    fprintf(stderr, "  -C            Compara políticas y modos del puente con distintas cargas (CSV, con simulación)\n");
+    fprintf(stderr, "  -B archivo    Corre en paralelo los puentes del archivo, uno por línea: nombre y claves del\n");
+    fprintf(stderr, "                barrido con un valor, ej. \"norte puente=10 politica=ewma\" (con simulación)\n");
+    fprintf(stderr, "  -R archivo    Corre una red de tramos: el formato de -B con hacia_der, hacia_izq y viaje por\n");
+    fprintf(stderr, "                tramo (ver red.h); se reparte entre hilos y da lo mismo con cualquier -j\n");
+    fprintf(stderr, "  -H segundos   Con -R, segundos virtuales a simular (por defecto %d)\n", NETWORK_HORIZON);
+    fprintf(stderr, "  -o archivo    Con -S o -C, escribe el CSV en el archivo en vez de stdout\n");
+    fprintf(stderr, "  -j hilos      Con -S, -C, -B o -R, cantidad de hilos (por defecto uno por procesador)\n");
+    fprintf(stderr, "  -M nombre     Publica las métricas en el segmento de memoria compartida \"nombre\" para el\n");
+    fprintf(stderr, "                programa monitor (con hilos o con -s)\n");
+    fprintf(stderr, "  -A nombre     Con hilos, las llegadas las envían procesos alimentadores conectados al segmento\n");
+    fprintf(stderr, "                de memoria compartida \"nombre\" (ver alimentador); pueden entrar y salir en\n");
+    fprintf(stderr, "                cualquier momento\n");
+    fprintf(stderr, "  -E porcentaje Porcentaje de llegadas que son emergencias (por defecto 0): van a un carril propio\n");
+    fprintf(stderr, "                que el puente atiende primero y cortan el lote del lado contrario\n");
+    fprintf(stderr, "  -K archivo    Con -s, guarda un punto de control en el archivo cada -k segundos virtuales\n");
+    fprintf(stderr, "                (por defecto %d) y al terminar, sin detener la simulación\n", CHECKPOINT_INTERVAL);
+    fprintf(stderr, "  -L archivo    Con -s, sigue desde un punto de control. Puente, colas y llegadas son los\n");
+    fprintf(stderr, "                guardados; -n, -D, -P, -E y -r, si se dan, los reemplazan (-r cambia las\n");
+    fprintf(stderr, "                llegadas futuras)\n");
+    fprintf(stderr, "  -J archivo    Con hilos o con -s, escribe una línea JSON de estadísticas cada -I segundos y\n");
+    fprintf(stderr, "                otra al terminar (\"-\": stdout). Con -s el intervalo es de tiempo virtual\n");
+    fprintf(stderr, "  -I segundos   Intervalo de -J (por defecto %d)\n", STATS_INTERVAL);
+    fprintf(stderr, "Con kill -USR1 se imprimen las latencias acumuladas en stderr.\n");
+}
+
+// Con hilos, el hilo de control termina la corrida igual que el puente al llegar a un límite.
+static void cancelThreaded(void *ctx, StopReason why) {
+    (void)why;
+    requestStop((Estacionamiento*)ctx);
+}
+
+// En la simulación de eventos basta con marcarla: stepSimulation() se detiene entre dos eventos.
+static void cancelSimulation(void *ctx, StopReason why) {
+    (void)why;
+    ATOMIC_STORE(&((Simulacion*)ctx)->cancelled, 1);
+}
+
+// Error al crear un segmento de -A o -M; EEXIST quiere decir que el nombre es de otra corrida en marcha.
+static void segmentError(const char *name) {
+    if (errno == EEXIST) {
+        fprintf(stderr, "%s: lo usa otra corrida en ejecución\n", name);
+    } else {
+        perror(name);
+    }
+}
+
+static void closeStats() {
+    if (statsOut != stdout) {
+        fclose(statsOut);
+    }
+    statsOut = NULL;
+}
+
+int main(int argc, char *argv[]) {
+    int opt;
+    while ((opt = getopt(argc, argv, "sn:vf:itbS:o:j:P:CT:r:d:g:B:R:H:M:A:E:K:k:L:D:W:J:I:")) != -1) {
+        switch (opt) {
+        case 's': headless = 1; break;
+        case 'n': maxVehicles = atoll(optarg); givenOptions |= GIVEN_VEHICLES; break;
+        case 'v': verbose = 1; break;
+        case 'f': renderFps = atoi(optarg); break;
+        case 'i': incremental = 1; break;
+        case 't': pipelined = 1; break;
+        case 'b': bulk = 1; break;
+        case 'S': sweepSpec = optarg; break;
+        case 'o': sweepOutput = optarg; break;
+        case 'j': sweepThreads = atoi(optarg); break;
+        case 'P':
+            if (findPolicy(optarg) < 0) {
+                fprintf(stderr, "Política desconocida: %s\n", optarg);
+                usage(argv[0]);
+                return 1;
+            }
+            policy = (PolicyKind)findPolicy(optarg);
+            givenOptions |= GIVEN_POLICY;
+            break;
+        case 'C': comparePolicies = 1; break;
+        case 'T': tracePath = optarg; break;
+        case 'B': facilityPath = optarg; break;
+        case 'R': networkPath = optarg; break;
+        case 'H': networkHorizon = atof(optarg); break;
+        case 'M': metricsName = optarg; break;
+        case 'A': feedName = optarg; break;
+        case 'E':
+            priorityPercent = atof(optarg);
+            if (priorityPercent < 0 || priorityPercent > 100) {
+                fprintf(stderr, "El porcentaje de emergencias va de 0 a 100\n");
+                return 1;
+            }
+            givenOptions |= GIVEN_PRIORITY;
+            break;
+        case 'K': checkpointPath = optarg; break;
+        case 'k':
+            checkpointInterval = atof(optarg);
+            if (checkpointInterval <= 0) {
+                fprintf(stderr, "El intervalo entre puntos de control debe ser positivo\n");
+                return 1;
+            }
+            break;
+        case 'L': restorePath = optarg; break;
+        case 'D':
+            maxDuration = atof(optarg);
+            if (maxDuration <= 0) {
+                fprintf(stderr, "La duración debe ser positiva\n");
+                return 1;
+            }
+            givenOptions |= GIVEN_DURATION;
+            break;
+        case 'W':
+            wallLimit = atof(optarg);
+            if (wallLimit <= 0) {
+                fprintf(stderr, "El límite de tiempo real debe ser positivo\n");
+                return 1;
+            }
+            break;
+        case 'J': statsPath = optarg; break;
+        case 'I':
+            statsInterval = atof(optarg);
+            if (statsInterval <= 0) {
+                fprintf(stderr, "El intervalo de estadísticas debe ser positivo\n");
+                return 1;
+            }
+            break;
+        case 'r': seed = strtoull(optarg, NULL, 10); givenOptions |= GIVEN_SEED; break;
+        case 'g':
+            gates = atoi(optarg);
+            if (gates < 1) {
+                fprintf(stderr, "Se necesita al menos una puerta por lado\n");
+                return 1;
+            }
+            break;
+        case 'd':
+            if (findArrival(optarg) < 0) {
+                fprintf(stderr, "Distribución desconocida: %s\n", optarg);
+                usage(argv[0]);
+                return 1;
+            }
+            arrival = (ArrivalKind)findArrival(optarg);
+            break;
+        default:
+            usage(argv[0]);
+            return 1;
+        }
+    }
+    if (seed == 0) {
+        struct timespec now;
+        clock_gettime(CLOCK_REALTIME, &now);
+        seed = (unsigned long long)now.tv_sec * 1000000000ULL + (unsigned long long)now.tv_nsec;
+    }
+    if ((checkpointPath != NULL || restorePath != NULL) &&
+        (!headless || sweepSpec != NULL || comparePolicies || networkPath != NULL || facilityPath != NULL)) {
+        fprintf(stderr, "-K y -L son para la simulación de eventos de un puente (-s)\n");
+        return 1;
+    }
+    if ((wallLimit > 0 || statsPath != NULL) &&
+        (sweepSpec != NULL || comparePolicies || networkPath != NULL || facilityPath != NULL)) {
+        fprintf(stderr, "-W y -J son para la corrida de un puente, con hilos o con -s\n");
+        return 1;
+    }
+    if (((givenOptions & GIVEN_DURATION) || wallLimit > 0) && !(givenOptions & GIVEN_VEHICLES)) {
+        maxVehicles = LLONG_MAX;        // Sin -n manda el tiempo.
+    }
+    if (statsPath != NULL) {
+        statsOut = (strcmp(statsPath, "-") == 0) ? stdout : fopen(statsPath, "w");
+        if (statsOut == NULL) {
+            perror(statsPath);
+            return 1;
+        }
+    }
+    if (sweepSpec != NULL || comparePolicies) {
+        return runParameterSweep();
+    }
+    if (networkPath != NULL) {
+        return runNetworkFile();
+    }
+    if (facilityPath != NULL) {
+        return runFacility();
+    }
+    if (headless) {
+        if (feedName != NULL) {
+            fprintf(stderr, "-A necesita el modelo con hilos: la simulación de eventos genera sus llegadas\n");
+            return 1;
+        }
+        return runHeadless();
+    }
+
+    // Inicializar la instancia
+    SimParams params;
+    defaultParams(&params);
+    est = createEstacionamiento(&params);
+    if (est == NULL) {
+        fprintf(stderr, "No se pudo crear el estacionamiento\n");
+        return 1;
+    }
+    // Antes de ncurses, para que los errores se vean en la terminal.
+    if (feedName != NULL && createFeed(&feed, feedName) != 0) {
+        segmentError(feedName);
+        destroyEstacionamiento(est);
+        return 1;
+    }
+    if (metricsName != NULL && openMetricsWriter(&metrics, metricsName, &params, 0) != 0) {
+        segmentError(metricsName);
+        metricsName = NULL;     // La corrida sigue, sin métricas.
+    }
+    if (tracePath != NULL) {
+        // Con traza no se usa la pantalla: cada evento es solo un registro en el archivo.
+        if (openTraceWriter(&traceFile, tracePath, TRACE_RECORDS, &params) != 0) {
+            perror(tracePath);
+            if (feedName != NULL) {
+                closeFeed(&feed);
+            }
+            destroyEstacionamiento(est);
+            return 1;
+        }
+        renderFps = 0;
+    } else {
+        // Inicializar ncurses
+        initscr();
+        cbreak();
+        noecho();
+        curs_set(FALSE);
+        if (incremental) {
+            idlok(stdscr, TRUE);    // Permite desplazar el historial de mensajes con operaciones de línea.
+        }
+
+        initMessageRing(&messageRing);
+    }
+    pthread_t arrivals, puente, render, publisher, stats, intake[3];
+    RunControl control;
+    Rng fill;
+    seedRng(&fill, params.seed, 0);
+    installStatsSignal();
+
+    // Llenado inicial de las colas, llegan en el instante 0 y entran juntos a cada cola
+    int initial_amount[3];
+    initial_amount[1] = 4 + randomBelow(&fill, 3);
+    initial_amount[2] = 4 + randomBelow(&fill, 3);
+    for (int side = 1; side <= 2; side++) {
+        int ids[8];
+        for (int i = 0; i < initial_amount[side]; i++) {
+            ids[i] = prepareVehicle(&est->vehicles[side], 0);
+            commitVehicle(&est->vehicles[side]);
+            if (tracePath != NULL) {
+                traceEvent(&traceFile, 0, (side == 1) ? 'l' : 'r', ids[i], 0, params.windowSize);
+            }
+        }
+        int added = queueAddMany((side == 1) ? est->leftBuffer : est->rightBuffer, ids, initial_amount[side]);
+        for (int i = 0; i < added; i++) {
+            sem_post((side == 1) ? &est->leftItems : &est->rightItems);
+        }
+    }
+
+    // Inicializar mutex
     pthread_mutex_init(&printMutex, NULL);
+#ifdef LOCK_PROFILE
+    contentionRegister(&est->leftSemaphore, "leftSemaphore");
+    contentionRegister(&est->rightSemaphore, "rightSemaphore");
+    contentionRegister(&est->parkingSemaphore, "parkingSemaphore");
+    contentionRegister(&printMutex, "printMutex");
+#endif
 
     // Obtener y guardar el tiempo al inicio del programa
     clock_gettime(CLOCK_MONOTONIC, &start_time);
 
-    // Crear hilos
-    pthread_create(&puente, NULL, recorrerEstacionamiento, NULL);
-    pthread_create(&leftIn, NULL, newVehiculo, &left_id );
-    pthread_create(&rightIn, NULL, newVehiculo, &right_id );
+    // Crear hilos; el de control va primero para que los demás hereden SIGINT y SIGTERM bloqueadas.
+    if (startRunControl(&control, (long long)(wallLimit * 1000000), cancelThreaded, est) != 0) {
+        fprintf(stderr, "No se pudo crear el hilo de control\n");
+        destroyEstacionamiento(est);
+        return 1;
+    }
+    if (renderFps > 0) {
+        ATOMIC_STORE(&renderRunning, 1);
+        pthread_create(&render, NULL, renderLoop, NULL);
+    }
+    if (metricsName != NULL) {
+        ATOMIC_STORE(&metricsRunning, 1);
+        pthread_create(&publisher, NULL, metricsLoop, NULL);
+    }
+    if (statsOut != NULL) {
+        pthread_create(&stats, NULL, statsLoop, NULL);
+    }
+    pthread_create(&puente, NULL, recorrerEstacionamiento, est);
+    if (feedName != NULL) {
+        for (int side = 1; side <= 2; side++) {
+            pthread_create(&intake[side], NULL, feedIntake, &feedSides[side]);
+        }
+    } else {
+        pthread_create(&arrivals, NULL, arrivalScheduler, est);
+    }
 
     // Esperar a que terminen los hilos
-    pthread_join(leftIn, NULL);
-    pthread_join(rightIn, NULL);
+    if (feedName != NULL) {
+        pthread_join(intake[1], NULL);
+        pthread_join(intake[2], NULL);
+    } else {
+        pthread_join(arrivals, NULL);
+    }
     pthread_join(puente, NULL);
+    StopReason stopped = finishRunControl(&control);
+    if (renderFps > 0) {
+        ATOMIC_STORE(&renderRunning, 0);
+        pthread_join(render, NULL);
+    }
+    if (metricsName != NULL) {
+        ATOMIC_STORE(&metricsRunning, 0);
+        pthread_join(publisher, NULL);
+        publishThreaded();  // Foto final.
+        closeMetrics(&metrics);
+    }
+    if (statsOut != NULL) {
+        MetricsSnapshot last;
+        pthread_join(stats, NULL);
+        snapshotThreaded(&last);
+        writeStats(&last, 0);
+        closeStats();
+    }
 
-    // Destruir semáforos y mutex
-    sem_destroy(&leftSemaphore);
-    sem_destroy(&rightSemaphore);
-    sem_destroy(&parkingSemaphore);
+    // Destruir mutex
     pthread_mutex_destroy(&printMutex);
 
-    // Liberar el buffer de mensajes
-    freeMessageBuffer();
+    if (tracePath != NULL) {
+        closeTrace(&traceFile);
+    } else {
+        // Terminar ncurses
+        endwin();
+    }
+
+    // Reporte final de latencias
+    if (feedName != NULL) {
+        FeedSegment *fs = feed.segment;
+        printf("Alimentadores: %d conexiones, izquierda %lld recibidas (%lld descartadas en el anillo), "
+               "derecha %lld (%lld), %lld espacios abandonados\n", ATOMIC_LOAD(&fs->attachments),
+               ATOMIC_LOAD(&fs->rings[1].sent), ATOMIC_LOAD(&fs->rings[1].dropped),
+               ATOMIC_LOAD(&fs->rings[2].sent), ATOMIC_LOAD(&fs->rings[2].dropped),
+               ATOMIC_LOAD(&fs->rings[1].abandoned) + ATOMIC_LOAD(&fs->rings[2].abandoned));
+        closeFeed(&feed);
+    } else {
+        printf("Llegadas: %s, semilla %llu\n", arrivalName(params.arrival), params.seed);
+    }
+    if (stopped != STOP_NONE) {
+        printf("Corrida detenida a los %.1f s: %s\n", get_time(), stopReasonName(stopped));
+    }
+    if (params.priorityShare > 0) {
+        printf("Emergencias: %.1f%% de las llegadas, %lld lotes cortados\n", priorityPercent,
+               ATOMIC_LOAD(&est->preemptions));
+    }
+    printLatencyReport(stdout, est->latency);
+    printPriorityReport(stdout, est->priorityLatency);
+#ifdef LOCK_PROFILE
+    printContentionReport(stdout, get_time_us());
+    freeContention();
+#endif
+    destroyEstacionamiento(est);
+
+    return 0;
+}
+
+// Foto de la simulación de eventos; el reloj de la foto es el tiempo virtual.
+static void snapshotSimulation(const Simulacion *sim, MetricsSnapshot *snap) {
+    memset(snap, 0, sizeof(*snap));
+    snap->time = sim->now;
+    snap->wallTime = get_time_us();
+    snap->crossed = sim->contador_out;
+    snap->events = sim->eventsProcessed;
+    snap->flips = sim->flips;
+    snap->dir = sim->dir;
+    snap->window = sim->window;
+    snap->onBridge = countBuffer(sim->parking);
+    snap->queued[1] = countBuffer(sim->left);
+    snap->queued[2] = countBuffer(sim->right);
+    for (int side = 1; side <= 2; side++) {
+        snap->arrivals[side] = sim->arrivals[side];
+        snap->rejected[side] = sim->rejected[side];
+        summarizeLatency(&snap->wait[side], &sim->latency[side].wait);
+        summarizeLatency(&snap->total[side], &sim->latency[side].total);
+    }
+}
+
+static void publishSimulation(Simulacion *sim) {
+    MetricsSnapshot snap;
+    snapshotSimulation(sim, &snap);
+    publishMetrics(&metrics, &snap);
+}
+
+/**
+ * @brief Igual que runSimulation(), publicando una foto cada METRICS_INTERVAL_US de tiempo real.
+ *
+ * El reloj se consulta cada METRICS_SLICE_EVENTS eventos, no en cada uno.
+ */
+static void runPublishingSimulation(Simulacion *sim) {
+    long long nextPublish = 0;
+    while (stepSimulation(sim, METRICS_SLICE_EVENTS)) {
+        if (get_time_us() >= nextPublish) {
+            publishSimulation(sim);
+            nextPublish = get_time_us() + METRICS_INTERVAL_US;
+        }
+        if (statsReportRequested) {
+            statsReportRequested = 0;
+            printLatencyReport(stderr, sim->latency);
+        }
+    }
+    publishSimulation(sim);
+}
+
+// Con -K, stepSimulation() llama aquí entre dos eventos; si el hilo sigue escribiendo la foto anterior se omite.
+static void checkpointSimulation(void *ctx, const Simulacion *sim) {
+    takeCheckpoint((CheckpointWriter*)ctx, sim, 0);
+}
+
+// Con -J, una línea cada -I segundos virtuales: la misma semilla da las mismas líneas.
+static void sampleSimulation(void *ctx, const Simulacion *sim) {
+    MetricsSnapshot snap;
+    (void)ctx;
+    snapshotSimulation(sim, &snap);
+    writeStats(&snap, 1);
+}
+
+// Carga el punto de control de -L; las opciones dadas en la línea de comandos reemplazan a las guardadas.
+static int restoreSimulation(Simulacion *sim) {
+    if (loadCheckpoint(sim, restorePath) != 0) {
+        fprintf(stderr, "%s: %s\n", restorePath,
+                (errno == EINVAL) ? "no es un punto de control de este programa" : strerror(errno));
+        return -1;
+    }
+    sim->p.verbose = verbose;
+    if (givenOptions & (GIVEN_VEHICLES | GIVEN_DURATION)) {
+        sim->p.maxVehicles = maxVehicles;
+    }
+    if (givenOptions & GIVEN_DURATION) {
+        sim->p.maxDuration = (long long)(maxDuration * 1000000);
+    }
+    if ((givenOptions & GIVEN_POLICY) && policy != sim->p.policy) {
+        sim->p.policy = policy;
+        initPolicy(&sim->sched, policy, &sim->p.weights, sim->p.parkingSpeed);
+    }
+    if (givenOptions & GIVEN_PRIORITY) {
+        sim->p.priorityShare = priorityPercent / 100.0;
+    }
+    if (givenOptions & GIVEN_SEED) {
+        reseedSimulation(sim, seed);
+    }
+    return 0;
+}
+
+/**
+ * @brief Corre la simulación de eventos discretos con las mismas constantes que los hilos, o la que sigue
+ * desde el punto de control de -L.
+ */
+static int runHeadless() {
+    SimParams params;
+    defaultParams(&params);
+
+    Simulacion sim;
+    if (restorePath != NULL) {
+        if (restoreSimulation(&sim) != 0) {
+            return 1;
+        }
+        params = sim.p;
+    } else if (initSimulation(&sim, &params) != 0) {
+        fprintf(stderr, "No se pudo inicializar la simulación\n");
+        return 1;
+    }
+    if (tracePath != NULL) {
+        if (openTraceWriter(&traceFile, tracePath, TRACE_RECORDS, &params) != 0) {
+            perror(tracePath);
+            freeSimulation(&sim);
+            return 1;
+        }
+        sim.trace = &traceFile;
+        // Los vehículos del llenado inicial llegaron en el instante 0, antes de abrir la traza.
+        for (int side = 1; side <= 2 && restorePath == NULL; side++) {
+            for (int seq = 0; seq < sim.vehicles[side].nextSeq; seq++) {
+                traceEvent(&traceFile, 0, (side == 1) ? 'l' : 'r', 2 * seq + side, 0, params.windowSize);
+            }
+        }
+    }
+    if (checkpointPath != NULL) {
+        if (openCheckpointWriter(&checkpointWriter, checkpointPath) != 0) {
+            perror(checkpointPath);
+            freeSimulation(&sim);
+            return 1;
+        }
+        addPeriodic(&sim, (long long)(checkpointInterval * 1000000), checkpointSimulation, &checkpointWriter);
+    }
+    if (statsOut != NULL) {
+        addPeriodic(&sim, (long long)(statsInterval * 1000000), sampleSimulation, NULL);
+    }
+    if (restorePath != NULL) {
+        resumeSimulation(&sim);
+    }
+    installStatsSignal();
+    clock_gettime(CLOCK_MONOTONIC, &start_time);
+    if (metricsName != NULL && openMetricsWriter(&metrics, metricsName, &params, 1) != 0) {
+        segmentError(metricsName);
+        metricsName = NULL;
+    }
+    RunControl control;
+    if (startRunControl(&control, (long long)(wallLimit * 1000000), cancelSimulation, &sim) != 0) {
+        fprintf(stderr, "No se pudo crear el hilo de control\n");
+        freeSimulation(&sim);
+        return 1;
+    }
+    if (metricsName != NULL) {
+        runPublishingSimulation(&sim);
+        closeMetrics(&metrics);
+    } else {
+        runSimulation(&sim);
+    }
+    StopReason stopped = finishRunControl(&control);
+    if (statsOut != NULL) {
+        if (statsLines == 0 || statsPrev.time < sim.now) {
+            sampleSimulation(NULL, &sim);       // El estado final, si no coincidió con una línea.
+        }
+        closeStats();
+    }
+    printSimulationSummary(&sim, stdout, get_time());
+    if (stopped != STOP_NONE) {
+        printf("Corrida detenida a los %.1f s virtuales (%.1f s reales): %s\n", sim.now / 1e6, get_time(),
+               stopReasonName(stopped));
+    }
+    if (checkpointPath != NULL) {
+        takeCheckpoint(&checkpointWriter, &sim, 1);     // El estado final, para seguir con un -n mayor.
+        int err = closeCheckpointWriter(&checkpointWriter);
+        if (err != 0) {
+            fprintf(stderr, "%s: %s\n", checkpointPath, strerror(err));
+        }
+        fprintf(stderr, "Puntos de control: %lld escritos en %s, %lld omitidos\n", checkpointWriter.written,
+                checkpointPath, checkpointWriter.skipped);
+    }
+    freeSimulation(&sim);
+    if (tracePath != NULL) {
+        closeTrace(&traceFile);
+    }
+    return 0;
+}
+
+/**
+ * @brief Corre el barrido de parámetros pedido con -S (o la comparación de políticas de -C) partiendo de
+ * los parámetros por defecto.
+ */
+static int runParameterSweep() {
+    SimParams params;
+    defaultParams(&params);
+
+    FILE *out = stdout;
+    if (sweepOutput != NULL) {
+        out = fopen(sweepOutput, "w");
+        if (out == NULL) {
+            perror(sweepOutput);
+            return 1;
+        }
+    }
+    int status = comparePolicies ? runPolicyComparison(&params, sweepThreads, out)
+                                 : runSweep(&params, sweepSpec, sweepThreads, out);
+    if (out != stdout) {
+        fclose(out);
+    }
+    return (status == 0) ? 0 : 1;
+}
+
+// Una fila por puente con el avance publicado al final de su último tramo, y el total de la instalación.
+static void drawFacility(Instalacion *f, double elapsed) {
+    long long crossed = 0;
+    double throughput = 0;
+    int rows = LINES - 4;
 
-    // Terminar ncurses
-    endwin();
+    erase();
+    mvprintw(0, 0, "Instalación: %d puentes, %d en marcha, %.1f s", f->count, facilityPending(f), elapsed);
+    mvprintw(2, 0, "%-16s %12s %12s %12s", "Puente", "Vehiculos", "Tiempo_s", "Veh/s");
+    for (int i = 0; i < f->count; i++) {
+        FacilityBridge *b = &f->bridges[i];
+        long long done = ATOMIC_LOAD(&b->crossed);
+        double seconds = ATOMIC_LOAD(&b->now) / 1e6;
+        double rate = (seconds > 0) ? done / seconds : 0;
+        crossed += done;
+        throughput += rate;
+        if (i < rows) {
+            mvprintw(3 + i, 0, "%-16s %12lld %12.1f %12.4f%s", b->name, done, seconds, rate,
+                     ATOMIC_LOAD(&b->done) ? "  listo" : "");
+        }
+    }
+    int last = 3 + ((f->count < rows) ? f->count : rows);
+    mvprintw(last, 0, "%-16s %12lld %12s %12.4f", "Total", crossed, "", throughput);
+    refresh();
+}
+
+/**
+ * @brief Corre los puentes del archivo de -B en paralelo. Sin -s muestra el avance en pantalla mientras
+ * tanto; al final imprime el resumen de cada puente y el total.
+ */
+static int runFacility() {
+    SimParams params;
+    Instalacion facility;
+    defaultParams(&params);
+    if (loadFacility(&facility, &params, facilityPath) != 0) {
+        return 1;
+    }
 
+    clock_gettime(CLOCK_MONOTONIC, &start_time);
+    if (startFacility(&facility, sweepThreads) != 0) {
+        fprintf(stderr, "No se pudo iniciar la instalación\n");
+        freeFacility(&facility);
+        return 1;
+    }
+    if (!headless) {
+        initscr();
+        curs_set(FALSE);
+        while (facilityPending(&facility) > 0) {
+            drawFacility(&facility, get_time());
+            my_sleep(FACILITY_REFRESH_US);
+        }
+        drawFacility(&facility, get_time());
+        endwin();
+    }
+    finishFacility(&facility);
+    printFacilitySummary(&facility, stdout, get_time());
+    freeFacility(&facility);
+    return 0;
+}
+
+/**
+ * @brief Corre la red de tramos de -R hasta el horizonte e imprime el resumen.
+ *
+ * Es tiempo virtual: no hay pantalla, cada partición avanza tan rápido como puede.
+ */
+static int runNetworkFile() {
+    SimParams params;
+    Red net;
+    defaultParams(&params);
+    if (loadNetwork(&net, &params, networkPath) != 0) {
+        return 1;
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &start_time);
+    if (runNetwork(&net, sweepThreads, networkHorizon) != 0) {
+        fprintf(stderr, "No se pudo correr la red\n");
+        freeNetwork(&net);
+        return 1;
+    }
+    printNetworkSummary(&net, stdout, get_time());
+    freeNetwork(&net);
     return 0;
 }
 
@@ -225,132 +1248,348 @@ double get_time() {
     return elapsed_time;
 }
 
+long long get_time_us() {
+    struct timespec current_time;
+    clock_gettime(CLOCK_MONOTONIC, &current_time);
+    return (current_time.tv_sec - start_time.tv_sec) * 1000000LL
+         + (current_time.tv_nsec - start_time.tv_nsec) / 1000;
+}
+
+// Espera hasta el instante absoluto "deadline" o hasta que se pida terminar con requestStop().
+static void waitStop(const struct timespec *deadline) {
+    pthread_once(&stopOnce, initStopCond);
+    pthread_mutex_lock(&stopMutex);
+    while (!ATOMIC_LOAD(&stopping) && pthread_cond_timedwait(&stopCond, &stopMutex, deadline) != ETIMEDOUT) {
+        // Despertar espurio: se sigue esperando el mismo plazo.
+    }
+    pthread_mutex_unlock(&stopMutex);
+}
+
 void my_sleep(int microseconds) {
+    if (ATOMIC_LOAD(&stopping)) {
+        return;
+    }
     struct timespec ts;
-    ts.tv_sec = microseconds / 1000000;             // Convertir microsegundos a segundos
-    ts.tv_nsec = (microseconds % 1000000) * 1000;   // Convertir el residuo a nanosegundos
-    nanosleep(&ts, NULL);
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    ts.tv_sec += microseconds / 1000000;            // Convertir microsegundos a segundos
+    ts.tv_nsec += (microseconds % 1000000) * 1000;  // Convertir el residuo a nanosegundos
+    if (ts.tv_nsec >= 1000000000L) {
+        ts.tv_nsec -= 1000000000L;
+        ts.tv_sec++;
+    }
+    waitStop(&ts);
+}
+
+void sleep_until_us(long long microseconds) {
+    if (ATOMIC_LOAD(&stopping)) {
+        return;
+    }
+    struct timespec ts = start_time;
+    ts.tv_sec += microseconds / 1000000;
+    ts.tv_nsec += (microseconds % 1000000) * 1000;
+    if (ts.tv_nsec >= 1000000000L) {
+        ts.tv_nsec -= 1000000000L;
+        ts.tv_sec++;
+    }
+    waitStop(&ts);      // Una señal (SIGUSR1) no adelanta la llegada: solo despierta requestStop().
 }
 
 /**************************************
  *      *OTRAS FUNCIONES
  *************************************/
-// Estas funciones están aquí y no en funciones.c porque acceden a variables globales del main
-
-void updateWindowSize(CircularBuffer *leftBuf, CircularBuffer *rightBuf) {
-    int leftSize = countBuffer(leftBuf);
-    int rightSize = countBuffer(rightBuf);
-    int avgSize;
-    int newWindowSize;
 
-    // Calcula el tamaño promedio de los buffers
-    if (dir == 1) {                                                                                                                                                                        // Si la dirección es 1 (izquierda), se da más relevancia al tamaño del buffer izquierdo.
-        avgSize = (4 * leftSize + rightSize) / 5;
-        if (avgSize > leftSize) {
-            avgSize = leftSize;
-        }
-    } else {
-        // Si la dirección es 2 (derecha), se da más relevancia al tamaño del buffer derecho.
-        avgSize = (leftSize + 4 * rightSize) / 5;
-        if (avgSize > rightSize) {
-            avgSize = rightSize;
-        }
-    }
+void nextBatch(Estacionamiento *e) {
+    PolicyInput in;
+    WaitQueue *queues[3] = {NULL, e->leftBuffer, e->rightBuffer};
+    int dir, window;
 
-    // Calcula el nuevo tamaño de la ventana
-    newWindowSize = avgSize/1; // Ajustar este valor de acuerdo a lo necesario.
-    if (newWindowSize > 0) {
-        if (newWindowSize > PARKING_SIZE) {
-            ATOMIC_STORE(&window, PARKING_SIZE);  // Valor máximo para la ventana.
-        } else {
-            ATOMIC_STORE(&window, newWindowSize);
-        }
+    memset(&in, 0, sizeof(in));
+    in.dir = e->dir;
+    in.now = get_time_us();
+    in.oldest[0] = -1;
+    for (int side = 1; side <= 2; side++) {
+        int first = queuePeek(queues[side]);   // Solo este hilo retira, el primero no cambia mientras se lee.
+        in.count[side] = queueCount(queues[side]);
+        in.oldest[side] = (first > 0) ? vehicleTimes(&e->vehicles[side], first)->arrival : -1;
+        in.arrivals[side] = e->vehicles[side].committed;
+        in.priority[side] = ATOMIC_LOAD(&e->priorityWaiting[side]);
     }
-    else {
-        ATOMIC_STORE(&window, 1);   // Valor mínimo para la ventana.
+    decideNext(&e->sched, &in, &dir, &window);
+    if (dir != e->dir) {
+        COUNTER_INC(&e->flips);
     }
+    e->dir = dir;
+    ATOMIC_STORE(&e->window, window);
 }
 
 /**************************************
  *      *FUNCION PARA IMPRIMIR
  *************************************/
 
+/* Foto del estado que se muestra en pantalla */
+typedef struct {
+    double time;
+    int dir;
+    int window;
+    int done;
+    int leftCount, rightCount, parkingCount;
+    char left[BUFFER_SIZE];
+    char right[BUFFER_SIZE];
+    char parking[PARKING_SIZE];
+} DisplaySnapshot;
+
+/* Lo último que se dibujó en modo incremental */
+#define STATUS_INFO_SIZE    128     // Información general y los dos "Wait:", con holgura para números grandes
+#define STATUS_LINE_SIZE    (STATUS_INFO_SIZE + 2 * BUFFER_SIZE + PARKING_SIZE)
+static char lastStatusLine[STATUS_LINE_SIZE];
+static int lastStatusLength = 0;
+static MessageRecord lastMessages[MESSAGE_BUFFER_SIZE];
+static int lastCols = 0;
+
+static void printMessages() {
+    // Mostrar los últimos N mensajes
+    MessageRecord recent[MESSAGE_BUFFER_SIZE];
+    int count = recentMessages(&messageRing, recent, MESSAGE_BUFFER_SIZE);
+    for (int i = 0; i < count; i++) {
+        if (incremental) {
+            // Solo se reescriben las líneas cuyo evento cambió.
+            if (lastMessages[i].code == recent[i].code && lastMessages[i].value == recent[i].value) {
+                continue;
+            }
+            lastMessages[i] = recent[i];
+            mvprintw(10 + i, 0, "%s", eventMessage(recent[i].code));
+            clrtoeol();
+        } else {
+            mvprintw(10 + i, 0, "%s", eventMessage(recent[i].code));
+        }
+    }
+}
+
+static void beginFrame() {
+    if (!incremental) {
+        // Limpiar la pantalla
+        clear();
+    } else if (COLS != lastCols) {
+        // Cambió el ancho de la terminal: las posiciones guardadas ya no sirven.
+        clear();
+        lastCols = COLS;
+        lastStatusLength = 0;
+        memset(lastMessages, 0, sizeof(lastMessages));
+    }
+}
+
 void printState(char variable, int value) {
-    static const char* messages[] = {
-        ['a'] = "   Sale alguien de la cola izquierda.",
-        ['A'] = "   Entra alguien al puente desde la cola izquierda.",
-        ['b'] = "   Sale alguien de la cola derecha.",
-        ['B'] = "   Entra alguien al puente desde la cola derecha.",
-        ['O'] = "   Un vehículo cruzó.",
-        ['l'] = "   Una nuevo vehículo espera en la cola izquierda",
-        ['r'] = "   Una nuevo vehículo espera en la cola derecha",
-        ['*'] = "   Nadie nuevo sale de las colas.",
-        ['+'] = "   Nadie nuevo entra al puente."
-    };
-    pthread_mutex_lock(&printMutex);  // Adquirir el mutex antes de imprimir
-
-    // Limpiar la pantalla
-    clear();
+    // Con traza solo se guarda el registro binario, sin texto ni pantalla.
+    if (tracePath != NULL) {
+        traceEvent(&traceFile, get_time_us(), variable, value, est->dir, ATOMIC_LOAD(&est->window));
+        return;
+    }
+
+    // El registro se guarda sin bloqueo; el texto se arma solo si la línea llega a dibujarse.
+    logMessage(&messageRing, variable, value);
+
+    // Con hilo de dibujo la pantalla se resuelve allá.
+    if (renderFps > 0) {
+        return;
+    }
+
+    PROFILED_MUTEX_LOCK(&printMutex);  // Adquirir el mutex antes de imprimir
+
+    beginFrame();
 
     // Imprimir buffers y dirección
     printBuffersAndDirection();
 
-    // Almacenar el mensaje actual en el buffer circular
-    if (variable == 'O' && value == 1) {
-        ATOMIC_ADD(&contador_out, 1); // contador_out++
+    printMessages();
+
+    // Refrescar la pantalla para mostrar los cambios
+    refresh();
+
+    PROFILED_MUTEX_UNLOCK(&printMutex);  // Liberar el mutex después de imprimir
+}
+
+static void takeSnapshot(DisplaySnapshot *snap) {
+    // Cada buffer se copia de forma consistente sin bloquear a los hilos que lo modifican.
+    snap->time = get_time();
+    snap->dir = est->dir;
+    snap->window = ATOMIC_LOAD(&est->window);
+    snap->done = ATOMIC_LOAD(&est->contador_out);
+    snap->leftCount = snapshotQueue(est->leftBuffer, snap->left);
+    snap->rightCount = snapshotQueue(est->rightBuffer, snap->right);
+    snap->parkingCount = snapshotBuffer(est->parkingBuffer, snap->parking);
+}
+
+static void orderCells(char *out, const char *cells, int n, int reversed) {
+    for (int i = 0; i < n; i++) {
+        out[i] = cells[reversed ? n - 1 - i : i];
     }
-    const char* message = messages[(int)variable];
-    snprintf(messageBuffer[messageIndex], 256, "%s", message);
+}
 
-    // Incrementar el índice del buffer circular
-    messageIndex = (messageIndex + 1) % MESSAGE_BUFFER_SIZE;
-    if (messageCount < MESSAGE_BUFFER_SIZE) {
-        messageCount++;
+// Arma la línea de estado completa (información general, colas y puente) a partir de la foto, con un solo
+// snprintf: las celdas entran con %.*s, así el tamaño de cada tramo es conocido.
+static int composeStatusLine(const DisplaySnapshot *snap, char *line) {
+    char left[BUFFER_SIZE], parking[PARKING_SIZE];
+    orderCells(left, snap->left, BUFFER_SIZE, 1);
+    orderCells(parking, snap->parking, PARKING_SIZE, snap->dir == 1);
+    int len = snprintf(line, STATUS_LINE_SIZE,
+            "T:%8.4fs  Dir:%d  Window:%2d  Cruzando:%2d  Done:%3d   Wait:%2d %.*s   %.*s   %.*s Wait:%2d",
+            (snap->time * 10), snap->dir, snap->window, snap->parkingCount, snap->done,
+            snap->leftCount, BUFFER_SIZE, left,             // La cola izquierda
+            PARKING_SIZE, parking,                          // El buffer del estacionamiento
+            BUFFER_SIZE, snap->right, snap->rightCount);    // La cola derecha
+    if (len < 0) {
+        line[0] = '\0';
+        return 0;
     }
+    return (len < STATUS_LINE_SIZE - 1) ? len : STATUS_LINE_SIZE - 1;     // Cortada si no alcanzó.
+}
 
-    // Mostrar los últimos N mensajes
-    for (int i = 0; i < messageCount; i++) {
-        int index = (messageIndex + i) % MESSAGE_BUFFER_SIZE;
-        mvprintw(10 + i, 0, "%s", messageBuffer[index]);
+// Posición en pantalla del carácter "offset" de la línea de estado, que se corta al ancho de la terminal.
+static void putStatusChar(int offset, char c) {
+    mvaddch(offset / COLS, offset % COLS, c);
+}
+
+void printBuffersAndDirection() {
+    DisplaySnapshot snap;
+    char line[STATUS_LINE_SIZE];
+    takeSnapshot(&snap);
+    int len = composeStatusLine(&snap, line);
+
+    if (!incremental) {
+        // Mover el cursor a la posición inicial (fila 0, columna 0)
+        move(0, 0);
+        printw("%s\n", line);
+        return;
     }
 
-    // Refrescar la pantalla para mostrar los cambios
+    // Solo se envían los caracteres que cambiaron respecto del cuadro anterior.
+    for (int i = 0; i < len; i++) {
+        if (i >= lastStatusLength || line[i] != lastStatusLine[i]) {
+            putStatusChar(i, line[i]);
+        }
+    }
+    for (int i = len; i < lastStatusLength; i++) {
+        putStatusChar(i, ' ');
+    }
+    memcpy(lastStatusLine, line, len);
+    lastStatusLength = len;
+}
+
+static void renderFrame() {
+    beginFrame();
+    printBuffersAndDirection();
+    printMessages();
     refresh();
+}
 
-    pthread_mutex_unlock(&printMutex);  // Liberar el mutex después de imprimir
+void* renderLoop(void* arg) {
+    (void)arg;
+    long long frame = 1000000000LL / renderFps;
+    PROFILED_THREAD("dibujo");
+    struct timespec next;
+    clock_gettime(CLOCK_MONOTONIC, &next);
+    while (ATOMIC_LOAD(&renderRunning)) {
+        // Plazo absoluto para mantener la tasa fija aunque dibujar tome tiempo.
+        next.tv_nsec += frame;
+        while (next.tv_nsec >= 1000000000L) {
+            next.tv_nsec -= 1000000000L;
+            next.tv_sec++;
+        }
+        clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &next, NULL);
+        renderFrame();
+    }
+    renderFrame();      // Último cuadro con el estado final.
+    return NULL;
 }
 
-void printBuffersAndDirection() {
-    // Mover el cursor a la posición inicial (fila 0, columna 0)
-    move(0, 0);
-
-    // Imprimir información general
-    printw("T:%8.4fs  Dir:%d  Window:%2d  Cruzando:%2d  Done:%3d",
-            (get_time() * 10), dir, ATOMIC_LOAD(&window), countBuffer(parkingBuffer), ATOMIC_LOAD(&contador_out));
-    
-    // Imprimir la cola izquierda
-    printw("   Wait:%2d ", countBuffer(leftBuffer));
-    printBuffer2(leftBuffer);
-    
-    // Imprimir el buffer del estacionamiento
-    printw("   ");
-    (dir == 1) ? printBuffer2(parkingBuffer) : printBuffer(parkingBuffer);
-    
-    // Imprimir la cola derecha
-    printw("   ");
-    printBuffer(rightBuffer);
-    printw(" Wait:%2d\n", countBuffer(rightBuffer));
-}
-
-void initMessageBuffer() {
-    for (int i = 0; i < MESSAGE_BUFFER_SIZE; i++) {
-        messageBuffer[i] = malloc(256 * sizeof(char));
-        strcpy(messageBuffer[i], "");
-    }
-}
-
-void freeMessageBuffer() {
-    for (int i = 0; i < MESSAGE_BUFFER_SIZE; i++) {
-        free(messageBuffer[i]);
-    }
-}
\ No newline at end of file
+// Foto de la instancia con hilos. Los histogramas los escribe solo el hilo del puente; leerlos desde aquí
+// puede dejar la foto un vehículo atrasada, nunca bloquea al puente.
+// Solo desde el hilo del puente, el único que escribe los histogramas.
+static void publishLatency(Estacionamiento *e) {
+    int seq = ATOMIC_LOAD_RLX(&publishedLatency.seq);
+    ATOMIC_STORE_RLX(&publishedLatency.seq, seq + 1);
+    ATOMIC_FENCE_REL();
+    for (int side = 1; side <= 2; side++) {
+        summarizeLatency(&publishedLatency.wait[side], &e->latency[side].wait);
+        summarizeLatency(&publishedLatency.total[side], &e->latency[side].total);
+    }
+    ATOMIC_STORE_REL(&publishedLatency.seq, seq + 2);
+}
+
+static void readPublishedLatency(MetricsSnapshot *snap) {
+    while (1) {
+        int start = ATOMIC_LOAD_ACQ(&publishedLatency.seq);
+        if (start & 1) {
+            sched_yield();      // El puente está publicando.
+            continue;
+        }
+        memcpy(snap->wait, publishedLatency.wait, sizeof(snap->wait));
+        memcpy(snap->total, publishedLatency.total, sizeof(snap->total));
+        ATOMIC_FENCE_ACQ();
+        if (ATOMIC_LOAD_RLX(&publishedLatency.seq) == start) {
+            return;
+        }
+    }
+}
+
+static void snapshotThreaded(MetricsSnapshot *snap) {
+    memset(snap, 0, sizeof(*snap));
+    snap->time = get_time_us();
+    snap->wallTime = snap->time;
+    snap->crossed = ATOMIC_LOAD_RLX(&est->contador_out);
+    snap->flips = ATOMIC_LOAD_RLX(&est->flips);
+    snap->dir = est->dir;
+    snap->window = ATOMIC_LOAD(&est->window);
+    snap->onBridge = countBuffer(est->parkingBuffer);
+    snap->queued[1] = queueCount(est->leftBuffer);
+    snap->queued[2] = queueCount(est->rightBuffer);
+    for (int side = 1; side <= 2; side++) {
+        snap->arrivals[side] = ATOMIC_LOAD_RLX(&est->sides[side].arrivals);
+        snap->rejected[side] = ATOMIC_LOAD_RLX(&est->sides[side].rejected);
+    }
+    readPublishedLatency(snap);     // Al último lote terminado.
+}
+
+static void publishThreaded() {
+    MetricsSnapshot snap;
+    snapshotThreaded(&snap);
+    publishMetrics(&metrics, &snap);
+}
+
+static void* metricsLoop(void* arg) {
+    (void)arg;
+    long long next = get_time_us();
+    // Al terminar la corrida sleep_until_us() ya no espera: la foto final la publica main después de los joins.
+    while (ATOMIC_LOAD(&metricsRunning) && !ATOMIC_LOAD(&stopping)) {
+        publishThreaded();
+        next += METRICS_INTERVAL_US;
+        sleep_until_us(next);
+    }
+    return NULL;
+}
+
+// Escribe una línea de -J; el throughput del intervalo se mide contra la línea anterior.
+static void writeStats(const MetricsSnapshot *snap, int virtualTime) {
+    printMetricsJson(statsOut, snap, (statsLines > 0) ? &statsPrev : NULL, virtualTime);
+    statsPrev = *snap;
+    statsLines++;
+}
+
+static void* statsLoop(void* arg) {
+    (void)arg;
+    long long every = (long long)(statsInterval * 1000000);
+    long long next = get_time_us();
+    MetricsSnapshot snap;
+    PROFILED_THREAD("estadisticas");
+    // Igual que metricsLoop(): la línea final la escribe main con el estado después de los joins.
+    while (!ATOMIC_LOAD(&stopping)) {
+        next += every;
+        sleep_until_us(next);
+        if (ATOMIC_LOAD(&stopping)) {
+            break;
+        }
+        snapshotThreaded(&snap);
+        writeStats(&snap, 0);
+    }
+    return NULL;
+}
@@ -0,0 +1,203 @@
+/**
+ * @file metricas.c
+ * @brief Definiciones de las métricas en memoria compartida.
+ *
+ * @date 16 de octubre de 2026 (creación)
+ * @version 1.0
+ * @authors
+ * Julio López
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <signal.h>
+#include <fcntl.h>
+#include <sched.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "metricas.h"
+
+static void segmentName(char *out, const char *name) {
+    snprintf(out, METRICS_NAME_SIZE, "%s%s", (name[0] == '/') ? "" : "/", name);
+}
+
+// Un segmento existente se puede reemplazar si no es de una corrida, si ya terminó o si su proceso no existe.
+static int staleMetrics(const char *name) {
+    int fd = shm_open(name, O_RDONLY, 0);
+    if (fd < 0) {
+        return errno == ENOENT;
+    }
+    struct stat st;
+    int stale = 1;
+    if (fstat(fd, &st) == 0 && (size_t)st.st_size >= sizeof(MetricsSegment)) {
+        MetricsSegment *s = mmap(NULL, sizeof(MetricsSegment), PROT_READ, MAP_SHARED, fd, 0);
+        if (s != MAP_FAILED) {
+            stale = memcmp(s->magic, METRICS_MAGIC, sizeof(s->magic)) != 0 || ATOMIC_LOAD(&s->finished) ||
+                    (kill(s->pid, 0) != 0 && errno == ESRCH);
+            munmap(s, sizeof(MetricsSegment));
+        }
+    }
+    close(fd);
+    return stale;
+}
+
+int openMetricsWriter(MetricsExport *m, const char *name, const SimParams *params, int virtualTime) {
+    memset(m, 0, sizeof(MetricsExport));
+    segmentName(m->name, name);
+    // O_EXCL: truncar el segmento de una corrida en marcha lo dejaría en ceros, y al terminar esta corrida
+    // closeMetrics() lo borraría.
+    int fd = shm_open(m->name, O_RDWR | O_CREAT | O_EXCL, 0644);
+    if (fd < 0 && errno == EEXIST) {
+        if (!staleMetrics(m->name)) {
+            errno = EEXIST;
+            return -1;
+        }
+        shm_unlink(m->name);
+        fd = shm_open(m->name, O_RDWR | O_CREAT | O_EXCL, 0644);
+    }
+    if (fd < 0) {
+        return -1;
+    }
+    if (ftruncate(fd, sizeof(MetricsSegment)) != 0) {
+        close(fd);
+        shm_unlink(m->name);
+        return -1;
+    }
+    void *map = mmap(NULL, sizeof(MetricsSegment), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) {
+        shm_unlink(m->name);
+        return -1;
+    }
+
+    // El segmento recién creado está en ceros; la marca se escribe al final para que un lector que se
+    // conecta entre medio lo rechace en vez de ver una cabecera a medias.
+    MetricsSegment *s = (MetricsSegment*)map;
+    s->version = METRICS_VERSION;
+    s->size = sizeof(MetricsSegment);
+    s->pid = (int32_t)getpid();
+    s->virtualTime = virtualTime;
+    s->bufferSize = params->bufferSize;
+    s->parkingSize = params->parkingSize;
+    s->parkingSpeed = params->parkingSpeed;
+    s->pipelined = params->pipelined;
+    s->policy = params->policy;
+    ATOMIC_STORE(&s->seq, 0);
+    ATOMIC_STORE(&s->finished, 0);
+    ATOMIC_FENCE_REL();
+    memcpy(s->magic, METRICS_MAGIC, sizeof(s->magic));
+    m->segment = s;
+    m->owner = 1;
+    return 0;
+}
+
+int openMetricsReader(MetricsExport *m, const char *name) {
+    memset(m, 0, sizeof(MetricsExport));
+    segmentName(m->name, name);
+    int fd = shm_open(m->name, O_RDONLY, 0);
+    if (fd < 0) {
+        return -1;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(MetricsSegment)) {
+        close(fd);
+        return -1;
+    }
+    void *map = mmap(NULL, sizeof(MetricsSegment), PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) {
+        return -1;
+    }
+    m->segment = (MetricsSegment*)map;
+    ATOMIC_FENCE_ACQ();
+    if (memcmp(m->segment->magic, METRICS_MAGIC, sizeof(m->segment->magic)) != 0 ||
+        m->segment->version != METRICS_VERSION || m->segment->size != sizeof(MetricsSegment)) {
+        closeMetrics(m);
+        return -1;
+    }
+    return 0;
+}
+
+void publishMetrics(MetricsExport *m, const MetricsSnapshot *snap) {
+    MetricsSegment *s = m->segment;
+    int seq = ATOMIC_LOAD_RLX(&s->seq);
+    ATOMIC_STORE_RLX(&s->seq, seq + 1);     // Impar: se está escribiendo.
+    ATOMIC_FENCE_REL();
+    memcpy(&s->data, snap, sizeof(MetricsSnapshot));
+    ATOMIC_STORE_REL(&s->seq, seq + 2);
+}
+
+int readMetrics(const MetricsExport *m, MetricsSnapshot *out) {
+    // El mapeo del lector es de solo lectura: se usan cargas simples con barreras, sin operaciones atómicas
+    // de lectura y escritura.
+    const MetricsSegment *s = m->segment;
+    for (int i = 0; i < METRICS_READ_TRIES; i++) {
+        int before = ATOMIC_LOAD_RLX(&s->seq);
+        ATOMIC_FENCE_ACQ();
+        if ((before & 1) == 0) {
+            memcpy(out, (const void*)&s->data, sizeof(MetricsSnapshot));
+            ATOMIC_FENCE_ACQ();
+            if (ATOMIC_LOAD_RLX(&s->seq) == before) {
+                return 0;
+            }
+        }
+        sched_yield();
+    }
+    return -1;
+}
+
+void summarizeLatency(MetricsLatency *out, const Histogram *h) {
+    out->count = h->count;
+    out->mean = (h->count > 0) ? h->sum / h->count : 0;
+    out->p50 = histPercentile(h, 50);
+    out->p90 = histPercentile(h, 90);
+    out->p99 = histPercentile(h, 99);
+    out->max = h->max;
+}
+
+// Vehículos por segundo entre dos fotos; sin foto anterior, el promedio desde el inicio.
+static double intervalRate(long long crossed, long long prevCrossed, long long elapsed) {
+    return (elapsed > 0) ? (crossed - prevCrossed) * 1e6 / elapsed : 0.0;
+}
+
+void printMetricsJson(FILE *out, const MetricsSnapshot *now, const MetricsSnapshot *prev, int virtualTime) {
+    static const char *suffix[3] = {"", "izq", "der"};
+    long long elapsed = now->time - ((prev != NULL) ? prev->time : 0);
+
+    fprintf(out, "{\"tiempo_s\":%.6f", now->time / 1e6);
+    if (!virtualTime) {
+        fprintf(out, ",\"real_s\":%.6f", now->wallTime / 1e6);
+    }
+    fprintf(out, ",\"vehiculos\":%lld,\"throughput\":%.6f,\"throughput_medio\":%.6f", (long long)now->crossed,
+            intervalRate(now->crossed, (prev != NULL) ? prev->crossed : 0, elapsed),
+            intervalRate(now->crossed, 0, now->time));
+    fprintf(out, ",\"direccion\":%d,\"ventana\":%d,\"cambios\":%lld,\"en_puente\":%d", now->dir, now->window,
+            (long long)now->flips, now->onBridge);
+    for (int side = 1; side <= 2; side++) {
+        const MetricsLatency *w = &now->wait[side];
+        fprintf(out, ",\"cola_%s\":%d,\"llegadas_%s\":%lld,\"rechazados_%s\":%lld", suffix[side],
+                now->queued[side], suffix[side], (long long)now->arrivals[side], suffix[side],
+                (long long)now->rejected[side]);
+        fprintf(out, ",\"throughput_%s\":%.6f", suffix[side],
+                intervalRate(now->total[side].count, (prev != NULL) ? prev->total[side].count : 0, elapsed));
+        fprintf(out, ",\"espera_p50_%s_s\":%.6f,\"espera_p90_%s_s\":%.6f,\"espera_p99_%s_s\":%.6f,"
+                "\"espera_max_%s_s\":%.6f", suffix[side], w->p50 / 1e6, suffix[side], w->p90 / 1e6,
+                suffix[side], w->p99 / 1e6, suffix[side], w->max / 1e6);
+    }
+    fprintf(out, "}\n");
+    fflush(out);
+}
+
+void closeMetrics(MetricsExport *m) {
+    if (m->segment == NULL) {
+        return;
+    }
+    if (m->owner) {
+        ATOMIC_STORE(&m->segment->finished, 1);
+        shm_unlink(m->name);
+    }
+    munmap(m->segment, sizeof(MetricsSegment));
+    m->segment = NULL;
+}
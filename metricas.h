@@ -0,0 +1,170 @@
+/**
+ * @file metricas.h
+ * @brief Métricas de la corrida publicadas en memoria compartida para un monitor externo.
+ *
+ * @details
+ * Con "main -M nombre" la corrida publica periódicamente (cada METRICS_INTERVAL_US de tiempo real) una foto de
+ * sus contadores en un segmento de memoria compartida POSIX (shm_open): dirección, ventana, vehículos en cada
+ * cola y en el puente, llegadas, rechazos y cruces por lado, y la espera y el tiempo total por lado. El
+ * programa monitor se conecta al segmento desde otra terminal y muestra las métricas sin tocar la corrida.
+ * La misma foto se puede escribir como una línea JSON (printMetricsJson()) para un flujo de estadísticas.
+ *
+ * La foto se protege con un seqlock: el único escritor deja la secuencia impar mientras copia y la vuelve a
+ * dejar par al terminar; el lector copia la foto y la descarta si la secuencia cambió entre medio. El escritor
+ * nunca espera al lector, y un monitor colgado o que nunca se conecta no afecta a la corrida.
+ *
+ * @date 16 de octubre de 2026 (creación)
+ * @version 1.0
+ * @authors
+ * Julio López
+ */
+
+#ifndef METRICAS_H
+#define METRICAS_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "funciones.h"
+
+#define METRICS_MAGIC           "PUENTEMT"
+#define METRICS_VERSION         2
+#define METRICS_DEFAULT_NAME    "/puente"   // Segmento por defecto del monitor
+#define METRICS_NAME_SIZE       64
+#define METRICS_INTERVAL_US     100000      // Cada cuánto se publica una foto (tiempo real)
+#define METRICS_SLICE_EVENTS    4096        // Con -s, eventos simulados entre consultas al reloj
+#define METRICS_READ_TRIES      64          // Intentos del lector antes de rendirse ante un escritor
+
+/**
+ * @brief Resumen de un histograma de latencias, en microsegundos.
+ */
+typedef struct {
+    int64_t count;      /**< Valores registrados */
+    int64_t mean;       /**< Promedio */
+    int64_t p50;        /**< Mediana */
+    int64_t p90;        /**< Percentil 90 */
+    int64_t p99;        /**< Percentil 99 */
+    int64_t max;        /**< Máximo */
+} MetricsLatency;
+
+/**
+ * @brief Foto de la corrida. Los arreglos por lado usan los índices 1 (izquierda) y 2 (derecha).
+ */
+typedef struct {
+    int64_t time;               /**< Reloj de la corrida (us); con -s es el tiempo virtual */
+    int64_t wallTime;           /**< Tiempo real desde el inicio (us) */
+    int64_t crossed;            /**< Vehículos que cruzaron */
+    int64_t events;             /**< Eventos atendidos (solo con -s) */
+    int64_t flips;              /**< Cambios de dirección */
+    int32_t dir;                /**< Dirección actual */
+    int32_t window;             /**< Ventana actual */
+    int32_t onBridge;           /**< Vehículos en el puente */
+    int32_t queued[3];          /**< Vehículos en cada cola */
+    int64_t arrivals[3];        /**< Llegadas por lado, incluidas las rechazadas */
+    int64_t rejected[3];        /**< Llegadas rechazadas por cola llena */
+    MetricsLatency wait[3];     /**< Tiempo en la cola */
+    MetricsLatency total[3];    /**< Desde la llegada hasta terminar de cruzar; count es lo cruzado por lado */
+} MetricsSnapshot;
+
+/**
+ * @brief Contenido del segmento compartido.
+ */
+typedef struct {
+    char magic[8];              /**< METRICS_MAGIC */
+    uint32_t version;           /**< METRICS_VERSION */
+    uint32_t size;              /**< sizeof(MetricsSegment) */
+    int32_t pid;                /**< Proceso que publica */
+    int32_t virtualTime;        /**< 1 si time es tiempo virtual (-s) */
+    int32_t bufferSize;         /**< Capacidad de cada cola */
+    int32_t parkingSize;        /**< Capacidad del puente */
+    int32_t parkingSpeed;       /**< Tiempo en microsegundos para avanzar un espacio */
+    int32_t pipelined;          /**< Modo del puente */
+    int32_t policy;             /**< Política de dirección y ventana */
+    ATOMIC_INT finished;        /**< 1 cuando la corrida terminó; la foto es la final */
+    ATOMIC_INT seq __attribute__((aligned(CACHE_LINE_SIZE)));  /**< Secuencia del seqlock, impar al escribir */
+    MetricsSnapshot data __attribute__((aligned(CACHE_LINE_SIZE)));     /**< Última foto */
+} MetricsSegment;
+
+/**
+ * @brief Segmento abierto por el escritor o por un lector.
+ */
+typedef struct {
+    MetricsSegment *segment;        /**< Segmento mapeado */
+    char name[METRICS_NAME_SIZE];   /**< Nombre para shm_open(), empieza con '/' */
+    int owner;                      /**< 1 si lo creó este proceso: lo borra al cerrar */
+} MetricsExport;
+
+
+/**
+ * @brief Crea (o reemplaza) el segmento y lo mapea para publicar.
+ *
+ * @param m Segmento a inicializar
+ * @param name Nombre; si no empieza con '/' se le agrega
+ * @param params Parámetros de la corrida, se guardan en la cabecera
+ * @param virtualTime 1 si el reloj de la corrida es virtual
+ * @return 0 si todo salió bien, -1 si no (errno indica la causa; EEXIST si el nombre es de otra corrida
+ * que sigue publicando)
+ */
+int openMetricsWriter(MetricsExport *m, const char *name, const SimParams *params, int virtualTime);
+
+
+/**
+ * @brief Se conecta a un segmento existente para leer.
+ *
+ * @param m Segmento a inicializar
+ * @param name Nombre; si no empieza con '/' se le agrega
+ * @return 0 si todo salió bien, -1 si no existe o no es un segmento de métricas
+ */
+int openMetricsReader(MetricsExport *m, const char *name);
+
+
+/**
+ * @brief Publica una foto. Solo puede haber un escritor.
+ *
+ * @param m Segmento abierto para escribir
+ * @param snap Foto a publicar
+ */
+void publishMetrics(MetricsExport *m, const MetricsSnapshot *snap);
+
+
+/**
+ * @brief Copia la última foto completa.
+ *
+ * @param m Segmento abierto
+ * @param out Foto leída
+ * @return 0 si se leyó una foto consistente, -1 si el escritor la estuvo cambiando en todos los intentos
+ */
+int readMetrics(const MetricsExport *m, MetricsSnapshot *out);
+
+
+/**
+ * @brief Resume un histograma para la foto.
+ *
+ * @param out Resumen
+ * @param h Histograma
+ */
+void summarizeLatency(MetricsLatency *out, const Histogram *h);
+
+
+/**
+ * @brief Escribe la foto como una línea JSON (JSON lines): reloj, vehículos, throughput del intervalo y
+ * promedio, dirección, ventana, cambios de dirección, ocupación, llegadas y rechazos, y percentiles de la
+ * espera por lado. Los tiempos van en segundos. Se vacía el búfer del archivo después de cada línea.
+ *
+ * @param out Destino
+ * @param now Foto
+ * @param prev Foto anterior, para el throughput del intervalo; NULL en la primera
+ * @param virtualTime 1 si el reloj es virtual: no se escribe el tiempo real y la salida es reproducible
+ */
+void printMetricsJson(FILE *out, const MetricsSnapshot *now, const MetricsSnapshot *prev, int virtualTime);
+
+
+/**
+ * @brief Marca la corrida como terminada (solo el escritor), libera el mapeo y, si lo creó este proceso,
+ * borra el segmento. Un monitor conectado conserva su mapeo y ve la foto final.
+ *
+ * @param m Segmento abierto
+ */
+void closeMetrics(MetricsExport *m);
+
+
+#endif
@@ -0,0 +1,109 @@
+/**
+ * @file monitor.c
+ * @brief Muestra las métricas que publica una corrida de main -M, desde otro proceso.
+ *
+ * @details
+ * Se conecta al segmento de memoria compartida (ver metricas.h) y cada intervalo imprime una línea con la
+ * dirección, la ventana, los vehículos en las colas y en el puente, lo cruzado, el throughput por sentido en
+ * el último intervalo y la espera p50/p99 por lado. Termina cuando la corrida termina, cuando el proceso que
+ * publica desaparece o después de -n líneas. Solo lee: la corrida no sabe si hay un monitor conectado.
+ *
+ * @date 16 de octubre de 2026 (creación)
+ * @version 1.0
+ * @authors
+ * Julio López
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <errno.h>
+#include <signal.h>
+#include <unistd.h>
+#include <time.h>
+#include "metricas.h"
+
+static void usage(const char *prog) {
+    fprintf(stderr, "Uso: %s [-i milisegundos] [-n lineas] [nombre]\n", prog);
+    fprintf(stderr, "  -i ms      Intervalo entre líneas (por defecto 1000)\n");
+    fprintf(stderr, "  -n lineas  Termina después de esta cantidad de líneas (por defecto, al terminar la corrida)\n");
+    fprintf(stderr, "  nombre     Segmento que publica main -M (por defecto %s)\n", METRICS_DEFAULT_NAME);
+}
+
+static void waitMilliseconds(int ms) {
+    struct timespec ts;
+    ts.tv_sec = ms / 1000;
+    ts.tv_nsec = (long)(ms % 1000) * 1000000L;
+    nanosleep(&ts, NULL);
+}
+
+static void printHeader(const MetricsSegment *s, const char *name) {
+    printf("Segmento %s, proceso %d: puente %d espacios, colas %d, velocidad %d us, modo %s, tiempo %s\n",
+           name, s->pid, s->parkingSize, s->bufferSize, s->parkingSpeed, s->pipelined ? "tubería" : "lotes",
+           s->virtualTime ? "virtual" : "real");
+    printf("%12s %3s %4s %6s %6s %6s %10s %9s %9s %9s %9s %9s %9s\n", "Tiempo_s", "Dir", "Vent", "Puente",
+           "ColaI", "ColaD", "Cruzados", "Veh/s_I", "Veh/s_D", "EspI_p50", "EspI_p99", "EspD_p50", "EspD_p99");
+}
+
+// Throughput de un sentido entre dos fotos; sin foto anterior, el promedio desde el inicio.
+static double sideRate(const MetricsSnapshot *now, const MetricsSnapshot *prev, int side) {
+    long long crossed = now->total[side].count - ((prev != NULL) ? prev->total[side].count : 0);
+    long long elapsed = now->time - ((prev != NULL) ? prev->time : 0);
+    return (elapsed > 0) ? crossed * 1e6 / elapsed : 0.0;
+}
+
+static void printLine(const MetricsSnapshot *now, const MetricsSnapshot *prev) {
+    printf("%12.3f %3d %4d %6d %6d %6d %10lld %9.4f %9.4f %9.3f %9.3f %9.3f %9.3f\n", now->time / 1e6,
+           now->dir, now->window, now->onBridge, now->queued[1], now->queued[2], (long long)now->crossed,
+           sideRate(now, prev, 1), sideRate(now, prev, 2), now->wait[1].p50 / 1e6, now->wait[1].p99 / 1e6,
+           now->wait[2].p50 / 1e6, now->wait[2].p99 / 1e6);
+    fflush(stdout);
+}
+
+int main(int argc, char *argv[]) {
+    int interval = 1000;
+    long long lines = 0;
+    int opt;
+    while ((opt = getopt(argc, argv, "i:n:")) != -1) {
+        switch (opt) {
+        case 'i': interval = atoi(optarg); break;
+        case 'n': lines = atoll(optarg); break;
+        default:
+            usage(argv[0]);
+            return 1;
+        }
+    }
+    if (interval <= 0) {
+        usage(argv[0]);
+        return 1;
+    }
+    const char *name = (optind < argc) ? argv[optind] : METRICS_DEFAULT_NAME;
+
+    MetricsExport m;
+    if (openMetricsReader(&m, name) != 0) {
+        fprintf(stderr, "%s: no hay una corrida publicando métricas\n", name);
+        return 1;
+    }
+    printHeader(m.segment, m.name);
+
+    MetricsSnapshot now, prev;
+    int havePrev = 0;
+    for (long long n = 0; lines <= 0 || n < lines; n++) {
+        int finished = ATOMIC_LOAD_RLX(&m.segment->finished);
+        if (readMetrics(&m, &now) == 0) {
+            printLine(&now, havePrev ? &prev : NULL);
+            prev = now;
+            havePrev = 1;
+        }
+        if (finished) {
+            printf("La corrida terminó\n");
+            break;
+        }
+        if (kill(m.segment->pid, 0) != 0 && errno == ESRCH) {
+            printf("El proceso %d ya no existe\n", m.segment->pid);
+            break;
+        }
+        waitMilliseconds(interval);
+    }
+    closeMetrics(&m);
+    return 0;
+}
@@ -0,0 +1,128 @@
+/**
+ * @file politicas.c
+ * @brief Definiciones de las políticas de dirección y ventana.
+ *
+ * @date 16 de octubre de 2026 (creación)
+ * @version 1.0
+ * @authors
+ * Julio López
+ */
+
+#include <string.h>
+#include "politicas.h"
+#include "funciones.h"
+
+static const char *policyNames[POLICY_COUNT] = {
+    "alternar", "heuristica", "presion", "antiguo", "ewma"
+};
+
+static int otherSide(int dir) {
+    return (dir == 1) ? 2 : 1;
+}
+
+static int clampWindow(int window, const WindowParams *wp) {
+    if (window > wp->maxWindow) {
+        return wp->maxWindow;
+    }
+    return (window > 0) ? window : 1;
+}
+
+// Actualiza la tasa de llegada de cada lado con las llegadas ocurridas desde la decisión anterior.
+static void updateRates(SchedPolicy *sp, const PolicyInput *in) {
+    long long elapsed = in->now - sp->lastTime;
+    if (elapsed <= 0) {
+        return;
+    }
+    for (int side = 1; side <= 2; side++) {
+        double measured = (double)(in->arrivals[side] - sp->lastArrivals[side]) / elapsed;
+        sp->rate[side] = EWMA_ALPHA * measured + (1 - EWMA_ALPHA) * sp->rate[side];
+        sp->lastArrivals[side] = in->arrivals[side];
+    }
+    sp->lastTime = in->now;
+}
+
+void initPolicy(SchedPolicy *sp, PolicyKind kind, const WindowParams *weights, int parkingSpeed) {
+    memset(sp, 0, sizeof(SchedPolicy));
+    sp->kind = kind;
+    sp->weights = *weights;
+    sp->parkingSpeed = parkingSpeed;
+}
+
+void decideNext(SchedPolicy *sp, const PolicyInput *in, int *dir, int *window) {
+    int same = (in->dir == 1 || in->dir == 2) ? in->dir : 2;   // Antes del primer lote se empieza por la izquierda.
+    int next = otherSide(same);
+    // Horizonte de la predicción: lo que tarda un lote completo en entrar y vaciarse.
+    double horizon = 2.0 * sp->weights.maxWindow * sp->parkingSpeed;
+
+    // Dirección
+    switch (sp->kind) {
+    case POLICY_MAX_PRESSURE:
+        // A igual largo se alterna, para no dejar esperando siempre al mismo lado.
+        if (in->count[same] > in->count[next]) {
+            next = same;
+        }
+        break;
+
+    case POLICY_OLDEST:
+        if (in->oldest[next] < 0 || (in->oldest[same] >= 0 && in->oldest[same] < in->oldest[next])) {
+            next = same;
+        }
+        break;
+
+    case POLICY_EWMA:
+        updateRates(sp, in);
+        if (in->count[same] + sp->rate[same] * horizon > in->count[next] + sp->rate[next] * horizon) {
+            next = same;
+        }
+        break;
+
+    default:
+        break;
+    }
+
+    // Nunca se cambia a una cola vacía si la otra tiene vehículos.
+    if (sp->kind != POLICY_ALTERNATE && in->count[next] == 0 && in->count[otherSide(next)] > 0) {
+        next = otherSide(next);
+    }
+
+    // Ventana
+    switch (sp->kind) {
+    case POLICY_MAX_PRESSURE:
+        *window = clampWindow(in->count[next], &sp->weights);
+        break;
+
+    case POLICY_EWMA:
+        // Se suman los vehículos que se espera que lleguen mientras entran los que ya esperan.
+        *window = clampWindow(in->count[next] + (int)(sp->rate[next] * in->count[next] * sp->parkingSpeed),
+                              &sp->weights);
+        break;
+
+    default:
+        *window = computeWindowSize(in->count[1], in->count[2], next, &sp->weights);
+        break;
+    }
+
+    // Las emergencias mandan sobre la política: primero las del lado que no tenía el paso, que pudieron cortar
+    // el lote que terminó. La ventana alcanza para todas las de ese lado, hasta el máximo.
+    int waiting = (in->priority[otherSide(same)] > 0) ? otherSide(same) : (in->priority[same] > 0) ? same : 0;
+    if (waiting != 0) {
+        next = waiting;
+        if (*window < in->priority[next]) {
+            *window = clampWindow(in->priority[next], &sp->weights);
+        }
+    }
+    *dir = next;
+}
+
+const char* policyName(PolicyKind kind) {
+    return (kind >= 0 && kind < POLICY_COUNT) ? policyNames[kind] : "?";
+}
+
+int findPolicy(const char *name) {
+    for (int i = 0; i < POLICY_COUNT; i++) {
+        if (strcmp(name, policyNames[i]) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
@@ -0,0 +1,120 @@
+/**
+ * @file politicas.h
+ * @brief Políticas que deciden la dirección y la ventana del siguiente lote del puente.
+ *
+ * @details
+ * Al terminar cada lote, el puente (el hilo de recorrerEstacionamiento() o la simulación de eventos) arma un
+ * PolicyInput con el estado de las colas y le pide a la política elegida al inicio la dirección y el tamaño
+ * de la ventana siguientes. Políticas disponibles:
+ *  - alternar: el comportamiento original, cambia siempre de dirección y usa computeWindowSize().
+ *  - heuristica: igual que alternar, pero no cambia de dirección si la cola contraria está vacía.
+ *  - presion: atiende la cola más larga (max-pressure) y la vacía hasta donde da el puente.
+ *  - antiguo: atiende la cola cuyo primer vehículo lleva más tiempo esperando.
+ *  - ewma: estima la tasa de llegada de cada lado con un promedio móvil exponencial y atiende el lado con más
+ *    carga prevista durante el próximo lote.
+ *
+ * Todas salvo alternar evitan cambiar a una cola vacía mientras la otra tenga vehículos.
+ * Con vehículos de emergencia esperando, cualquier política les da el paso (ver PolicyInput.priority).
+ *
+ * @date 16 de octubre de 2026 (creación)
+ * @version 1.0
+ * @authors
+ * Julio López
+ */
+
+#ifndef POLITICAS_H
+#define POLITICAS_H
+
+#define EWMA_ALPHA  0.25    // Peso de la última medición en el promedio de la tasa de llegada
+
+/**
+ * @brief Pesos de la heurística de ventana.
+ *
+ * La ventana es el promedio ponderado de las colas (la que tiene el paso pesa focusWeight y la contraria
+ * otherWeight), acotado por la cola que tiene el paso, dividido por divisor y limitado a [1, maxWindow].
+ */
+typedef struct {
+    int focusWeight;    /**< Peso de la cola que tiene el paso (4) */
+    int otherWeight;    /**< Peso de la cola contraria (1) */
+    int divisor;        /**< Divisor del promedio (1) */
+    int maxWindow;      /**< Ventana máxima, normalmente la capacidad del puente */
+} WindowParams;
+
+/**
+ * @brief Políticas disponibles, en el orden en que se listan con policyName().
+ */
+typedef enum {
+    POLICY_ALTERNATE,       /**< "alternar" */
+    POLICY_HEURISTIC,       /**< "heuristica" */
+    POLICY_MAX_PRESSURE,    /**< "presion" */
+    POLICY_OLDEST,          /**< "antiguo" */
+    POLICY_EWMA,            /**< "ewma" */
+    POLICY_COUNT
+} PolicyKind;
+
+/**
+ * @brief Estado de las colas al terminar un lote.
+ */
+typedef struct {
+    int dir;                /**< Dirección del lote que terminó (0 antes del primero) */
+    int count[3];           /**< Vehículos esperando por lado (índices 1 y 2) */
+    long long oldest[3];    /**< Llegada del primer vehículo de cada cola (us), -1 si está vacía */
+    int priority[3];        /**< Vehículos de emergencia esperando por lado; si hay, deciden la dirección */
+    long long arrivals[3];  /**< Llegadas aceptadas acumuladas por lado */
+    long long now;          /**< Instante de la decisión (us) */
+} PolicyInput;
+
+/**
+ * @brief Política elegida y su estado entre decisiones.
+ */
+typedef struct {
+    PolicyKind kind;            /**< Política */
+    WindowParams weights;       /**< Pesos de computeWindowSize() */
+    int parkingSpeed;           /**< Tiempo en microsegundos para avanzar un espacio */
+    double rate[3];             /**< Tasa de llegada estimada por lado (vehículos/us) */
+    long long lastArrivals[3];  /**< Llegadas vistas en la decisión anterior */
+    long long lastTime;         /**< Instante de la decisión anterior (us) */
+} SchedPolicy;
+
+
+/**
+ * @brief Inicializa una política.
+ *
+ * @param sp Política a inicializar
+ * @param kind Política elegida
+ * @param weights Pesos de la heurística de ventana
+ * @param parkingSpeed Tiempo en microsegundos para avanzar un espacio
+ */
+void initPolicy(SchedPolicy *sp, PolicyKind kind, const WindowParams *weights, int parkingSpeed);
+
+
+/**
+ * @brief Decide la dirección y la ventana del siguiente lote.
+ *
+ * @param sp Política
+ * @param in Estado de las colas
+ * @param dir Dirección elegida (1 izquierda, 2 derecha)
+ * @param window Ventana elegida, entre 1 y weights.maxWindow
+ */
+void decideNext(SchedPolicy *sp, const PolicyInput *in, int *dir, int *window);
+
+
+/**
+ * @brief Nombre de una política, el mismo que se usa en la línea de comandos.
+ *
+ * @param kind Política
+ * @return const char*
+ */
+const char* policyName(PolicyKind kind);
+
+
+/**
+ * @brief Busca una política por nombre.
+ *
+ * @param name Nombre de la política
+ * @return int La política, o -1 si no existe
+ */
+int findPolicy(const char *name);
+
+
+#endif
@@ -0,0 +1,384 @@
+/**
+ * @file red.c
+ * @brief Definiciones de la red de tramos con sincronización conservadora.
+ *
+ * @date 16 de octubre de 2026 (creación)
+ * @version 1.0
+ * @authors
+ * Julio López
+ */
+
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sched.h>
+#include <unistd.h>
+#include "red.h"
+
+#define NETWORK_LINE_SIZE   1024
+
+enum { KEY_RIGHT, KEY_LEFT, KEY_TRAVEL, KEY_COUNT };
+static const char *const networkKeys[KEY_COUNT + 1] = {"hacia_der", "hacia_izq", "viaje", NULL};
+
+/**************************************
+ *      *CANALES
+ *************************************/
+
+static int initChannel(Channel *ch, int capacity) {
+    ch->slots = malloc(capacity * sizeof(Transfer));
+    if (ch->slots == NULL) {
+        return -1;
+    }
+    ch->mask = capacity - 1;
+    ATOMIC_STORE(&ch->head, 0);
+    ATOMIC_STORE(&ch->tail, 0);
+    return 0;
+}
+
+static int channelPush(Channel *ch, const Transfer *t) {
+    int tail = ATOMIC_LOAD_RLX(&ch->tail);
+    if (tail - ATOMIC_LOAD_ACQ(&ch->head) > ch->mask) {
+        return 0;       // Lleno.
+    }
+    ch->slots[tail & ch->mask] = *t;
+    ATOMIC_STORE_REL(&ch->tail, tail + 1);
+    return 1;
+}
+
+static int channelPop(Channel *ch, Transfer *t) {
+    int head = ATOMIC_LOAD_RLX(&ch->head);
+    if (head == ATOMIC_LOAD_ACQ(&ch->tail)) {
+        return 0;       // Vacío.
+    }
+    *t = ch->slots[head & ch->mask];
+    ATOMIC_STORE_REL(&ch->head, head + 1);
+    return 1;
+}
+
+// Agenda en los tramos de la partición todo lo que le llegó. Los traspasos nunca caen en la ventana en curso.
+static void drainInbound(Red *net, Partition *part) {
+    Transfer t;
+    for (int from = 0; from < net->partCount; from++) {
+        Channel *ch = &net->channels[from * net->partCount + part->index];
+        while (channelPop(ch, &t)) {
+            injectVehicle(&net->segments[t.segment].sim, t.time, t.side, t.origin);
+        }
+    }
+}
+
+static void barrierWait(Red *net, Partition *part) {
+    SpinBarrier *b = &net->barrier;
+    int generation = ATOMIC_LOAD(&b->generation);
+    if (ATOMIC_ADD(&b->count, 1) == b->parties - 1) {
+        ATOMIC_STORE(&b->count, 0);
+        ATOMIC_ADD(&b->generation, 1);
+        return;
+    }
+    while (ATOMIC_LOAD(&b->generation) == generation) {
+        drainInbound(net, part);
+        sched_yield();
+    }
+}
+
+/**************************************
+ *      *TRASPASOS
+ *************************************/
+
+// Un vehículo terminó de cruzar el tramo: sigue al tramo que corresponde o sale de la red.
+static void segmentExit(void *ctx, long long time, int side, long long origin) {
+    NetworkSegment *seg = (NetworkSegment*)ctx;
+    Red *net = seg->net;
+    Partition *part = &net->parts[seg->partition];
+    int next = seg->route[side];
+    if (next < 0) {
+        seg->exits++;
+        histRecord(&part->networkTime, time - origin);
+        return;
+    }
+
+    Transfer t = {time + seg->travel, origin, next, side};
+    Channel *ch = &net->channels[part->index * net->partCount + net->segments[next].partition];
+    seg->sent++;
+    while (!channelPush(ch, &t)) {
+        // El destino vacía el canal aun esperando en la barrera; se vacían los propios por si el destino a su
+        // vez espera lugar en un canal hacia esta partición.
+        drainInbound(net, part);
+        sched_yield();
+    }
+}
+
+/**************************************
+ *      *ARCHIVO
+ *************************************/
+
+static int findSegment(const Red *net, const char *name) {
+    for (int i = 0; i < net->count; i++) {
+        if (strcmp(net->segments[i].name, name) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+int loadNetwork(Red *net, const SimParams *base, const char *path) {
+    memset(net, 0, sizeof(Red));
+    FILE *in = fopen(path, "r");
+    if (in == NULL) {
+        perror(path);
+        return -1;
+    }
+
+    // Se cuentan los tramos primero: van en un arreglo alineado que no se puede agrandar.
+    char line[NETWORK_LINE_SIZE];
+    int count = 0;
+    while (fgets(line, sizeof(line), in) != NULL) {
+        char *comment = strchr(line, '#');
+        if (comment != NULL) {
+            *comment = '\0';
+        }
+        if (strspn(line, " \t\r\n") != strlen(line)) {
+            count++;
+        }
+    }
+    if (count == 0) {
+        fprintf(stderr, "%s: no describe ningún tramo\n", path);
+        fclose(in);
+        return -1;
+    }
+    if (posix_memalign((void**)&net->segments, CACHE_LINE_SIZE, count * sizeof(NetworkSegment)) != 0) {
+        net->segments = NULL;
+        fclose(in);
+        return -1;
+    }
+    memset(net->segments, 0, count * sizeof(NetworkSegment));
+
+    // Los destinos se resuelven al final, cuando se conocen todos los nombres.
+    char (*routes)[2][FACILITY_NAME_SIZE] = calloc(count, sizeof(*routes));
+    int status = (routes != NULL) ? 0 : -1;
+    int lineNumber = 0;
+    rewind(in);
+    while (status == 0 && net->count < count && fgets(line, sizeof(line), in) != NULL) {
+        NetworkSegment *seg = &net->segments[net->count];
+        char *extra[KEY_COUNT];
+        SimParams p;
+        lineNumber++;
+        int parsed = parseBridgeLine(line, base, seg->name, &p, networkKeys, extra);
+        if (parsed == 0) {
+            continue;
+        }
+        char *end = NULL;
+        seg->travel = (long long)NETWORK_TRAVEL_SPEEDS * p.parkingSpeed;
+        if (parsed > 0 && extra[KEY_TRAVEL] != NULL) {
+            seg->travel = strtoll(extra[KEY_TRAVEL], &end, 10);
+        }
+        if (parsed < 0 || seg->travel <= 0 || (end != NULL && *end != '\0') || findSegment(net, seg->name) >= 0) {
+            fprintf(stderr, "%s:%d: línea inválida\n", path, lineNumber);
+            status = -1;
+            break;
+        }
+        snprintf(routes[net->count][0], FACILITY_NAME_SIZE, "%s", extra[KEY_RIGHT] ? extra[KEY_RIGHT] : "");
+        snprintf(routes[net->count][1], FACILITY_NAME_SIZE, "%s", extra[KEY_LEFT] ? extra[KEY_LEFT] : "");
+
+        p.maxVehicles = LLONG_MAX;      // En la red manda el horizonte.
+        p.maxDuration = 0;
+        seg->net = net;
+        net->count++;                   // También si falla: freeNetwork() libera lo que alcanzó a reservar.
+        if (initSimulation(&seg->sim, &p) != 0) {
+            status = -1;
+            break;
+        }
+        seg->sim.onExit = segmentExit;
+        seg->sim.exitCtx = seg;
+    }
+    fclose(in);
+
+    for (int i = 0; i < net->count && status == 0; i++) {
+        NetworkSegment *seg = &net->segments[i];
+        for (int side = 1; side <= 2; side++) {
+            const char *name = routes[i][side - 1];
+            seg->route[side] = (name[0] != '\0') ? findSegment(net, name) : -1;
+            if (name[0] != '\0' && seg->route[side] < 0) {
+                fprintf(stderr, "%s: el tramo %s sigue hacia %s, que no existe\n", path, seg->name, name);
+                status = -1;
+            }
+        }
+    }
+    free(routes);
+    if (status != 0) {
+        freeNetwork(net);
+    }
+    return status;
+}
+
+/**************************************
+ *      *EJECUCION
+ *************************************/
+
+static void* partitionLoop(void *arg) {
+    Partition *part = (Partition*)arg;
+    Red *net = part->net;
+    while (1) {
+        long long next = LLONG_MAX;
+        for (int i = part->first; i < part->last; i++) {
+            long long t = nextEventTime(&net->segments[i].sim);
+            next = (t < next) ? t : next;
+        }
+        ATOMIC_STORE(&part->nextTime, next);
+        barrierWait(net, part);
+
+        // Todas las particiones leen los mismos valores, así que todas deciden la misma ventana.
+        long long global = LLONG_MAX;
+        for (int p = 0; p < net->partCount; p++) {
+            long long t = ATOMIC_LOAD(&net->parts[p].nextTime);
+            global = (t < global) ? t : global;
+        }
+        if (global >= net->horizon) {
+            break;
+        }
+        long long end = (global < net->horizon - net->lookahead) ? global + net->lookahead : net->horizon;
+        for (int i = part->first; i < part->last; i++) {
+            advanceSimulation(&net->segments[i].sim, end);
+        }
+        part->windows++;
+
+        // Después de la barrera ya nadie envía en esta ventana: lo que queda en los canales es todo lo enviado.
+        barrierWait(net, part);
+        drainInbound(net, part);
+    }
+    return NULL;
+}
+
+int runNetwork(Red *net, int threads, double horizon) {
+    if (threads <= 0) {
+        threads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    }
+    if (threads > net->count) {
+        threads = net->count;
+    }
+    if (threads < 1) {
+        threads = 1;
+    }
+    net->horizon = (long long)(horizon * 1e6);
+    net->lookahead = net->horizon;
+    for (int i = 0; i < net->count; i++) {
+        const NetworkSegment *seg = &net->segments[i];
+        if ((seg->route[1] >= 0 || seg->route[2] >= 0) && seg->travel < net->lookahead) {
+            net->lookahead = seg->travel;
+        }
+    }
+
+    net->partCount = threads;
+    if (posix_memalign((void**)&net->parts, CACHE_LINE_SIZE, threads * sizeof(Partition)) != 0) {
+        net->parts = NULL;
+        return -1;
+    }
+    if (posix_memalign((void**)&net->channels, CACHE_LINE_SIZE, threads * threads * sizeof(Channel)) != 0) {
+        net->channels = NULL;
+        return -1;
+    }
+    memset(net->parts, 0, threads * sizeof(Partition));
+    memset(net->channels, 0, threads * threads * sizeof(Channel));
+    for (int i = 0; i < threads * threads; i++) {
+        if (initChannel(&net->channels[i], NETWORK_CHANNEL_SIZE) != 0) {
+            return -1;
+        }
+    }
+    // Bloques contiguos: en un camino descrito en orden, la mayoría de los traspasos quedan en la partición.
+    for (int p = 0; p < threads; p++) {
+        Partition *part = &net->parts[p];
+        part->net = net;
+        part->index = p;
+        part->first = (int)((long long)p * net->count / threads);
+        part->last = (int)((long long)(p + 1) * net->count / threads);
+        histInit(&part->networkTime);
+        for (int i = part->first; i < part->last; i++) {
+            net->segments[i].partition = p;
+        }
+    }
+    ATOMIC_STORE(&net->barrier.count, 0);
+    ATOMIC_STORE(&net->barrier.generation, 0);
+    net->barrier.parties = threads;
+
+    // La partición 0 la corre el hilo que llama.
+    int started = 1;
+    for (int p = 1; p < threads; p++) {
+        if (pthread_create(&net->parts[p].thread, NULL, partitionLoop, &net->parts[p]) != 0) {
+            break;
+        }
+        started++;
+    }
+    if (started < threads) {
+        // Sin todos los hilos la barrera nunca se completaría: se cancela la corrida.
+        net->horizon = LLONG_MIN;
+        net->barrier.parties = started;
+    }
+    partitionLoop(&net->parts[0]);
+    for (int p = 1; p < started; p++) {
+        pthread_join(net->parts[p].thread, NULL);
+    }
+    return (started == threads) ? 0 : -1;
+}
+
+/**************************************
+ *      *RESULTADOS
+ *************************************/
+
+void printNetworkSummary(const Red *net, FILE *out, double wallSeconds) {
+    Histogram networkTime;
+    long long crossed = 0;
+    long long entered = 0;
+    long long exits = 0;
+    long long rejected = 0;
+    long long events = 0;
+    double seconds = net->horizon / 1e6;
+
+    histInit(&networkTime);
+    fprintf(out, "%-16s %4s %10s %10s %10s %10s %10s %10s %10s\n", "Tramo", "Part", "Cruzaron", "Entraron",
+            "Recibidos", "Enviados", "Salieron", "Rechazos", "Veh/s");
+    for (int i = 0; i < net->count; i++) {
+        const NetworkSegment *seg = &net->segments[i];
+        const Simulacion *sim = &seg->sim;
+        long long received = sim->transfers[1] + sim->transfers[2];
+        long long external = sim->arrivals[1] + sim->arrivals[2] - received;
+        fprintf(out, "%-16s %4d %10lld %10lld %10lld %10lld %10lld %10lld %10.4f\n", seg->name, seg->partition,
+                sim->contador_out, external, received, seg->sent, seg->exits,
+                sim->rejected[1] + sim->rejected[2], (seconds > 0) ? sim->contador_out / seconds : 0.0);
+        crossed += sim->contador_out;
+        entered += external;
+        exits += seg->exits;
+        rejected += sim->rejected[1] + sim->rejected[2];
+        events += sim->eventsProcessed;
+    }
+    fprintf(out, "%-16s %4s %10lld %10lld %10s %10s %10lld %10lld\n", "Total", "", crossed, entered, "", "", exits,
+            rejected);
+    for (int p = 0; p < net->partCount; p++) {
+        histMerge(&networkTime, &net->parts[p].networkTime);
+    }
+    fprintf(out, "Red: %d tramos, %d particiones, lookahead %.3f s, %lld ventanas, %.3f s simulados\n",
+            net->count, net->partCount, net->lookahead / 1e6, (net->partCount > 0) ? net->parts[0].windows : 0,
+            seconds);
+    fprintf(out, "  %.3f s reales, %lld eventos", wallSeconds, events);
+    if (wallSeconds > 0) {
+        fprintf(out, " (%.0f eventos/s)", events / wallSeconds);
+    }
+    fprintf(out, "\n");
+    fprintf(out, "Tiempo en la red (s)   n %9lld  p50 %9.3f  p90 %9.3f  p99 %9.3f  max %9.3f\n", networkTime.count,
+            histPercentile(&networkTime, 50) / 1e6, histPercentile(&networkTime, 90) / 1e6,
+            histPercentile(&networkTime, 99) / 1e6, networkTime.max / 1e6);
+}
+
+void freeNetwork(Red *net) {
+    for (int i = 0; i < net->count; i++) {
+        freeSimulation(&net->segments[i].sim);
+    }
+    for (int i = 0; net->channels != NULL && i < net->partCount * net->partCount; i++) {
+        free(net->channels[i].slots);
+    }
+    free(net->segments);
+    free(net->parts);
+    free(net->channels);
+    net->segments = NULL;
+    net->parts = NULL;
+    net->channels = NULL;
+    net->count = 0;
+}
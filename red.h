@@ -0,0 +1,162 @@
+/**
+ * @file red.h
+ * @brief Red de tramos: los vehículos que cruzan un puente siguen hacia la cola de otro.
+ *
+ * @details
+ * El archivo tiene el formato de instalacion.h, con tres claves más por tramo:
+ *  - hacia_der: tramo al que siguen los vehículos que cruzan de izquierda a derecha; llegan a su cola izquierda
+ *  - hacia_izq: tramo al que siguen los que cruzan de derecha a izquierda; llegan a su cola derecha
+ *  - viaje: microsegundos de viaje hasta el tramo siguiente (por defecto NETWORK_TRAVEL_SPEEDS velocidades)
+ * Sin destino, el vehículo sale de la red. Las llegadas propias de cada tramo siguen funcionando: son los
+ * vehículos que entran a la red por ese tramo. Por ejemplo, un camino de tres tramos en los dos sentidos:
+ *
+ *     a   hacia_der=b
+ *     b   hacia_der=c hacia_izq=a
+ *     c   hacia_izq=b
+ *
+ * Los tramos se reparten en bloques contiguos entre las particiones, una por hilo. Un vehículo que pasa a un
+ * tramo de otra partición viaja por un canal de un productor y un consumidor (uno por par de particiones).
+ * La sincronización es conservadora por ventanas: todas las particiones acuerdan el menor instante pendiente
+ * t de la red y avanzan en paralelo hasta t + lookahead, donde lookahead es el menor viaje entre tramos.
+ * Como todo traspaso llega al menos un viaje después de salir, nada de lo que se envía en una ventana cae
+ * dentro de ella, y cada tramo atiende sus eventos en orden de tiempo sin importar cuántos hilos haya: el
+ * resultado es el mismo con cualquier cantidad de hilos.
+ *
+ * @date 16 de octubre de 2026 (creación)
+ * @version 1.0
+ * @authors
+ * Julio López
+ */
+
+#ifndef RED_H
+#define RED_H
+
+#include <stdio.h>
+#include "funciones.h"
+#include "simulacion.h"
+#include "instalacion.h"
+
+#define NETWORK_CHANNEL_SIZE    1024    // Traspasos en vuelo por canal
+#define NETWORK_TRAVEL_SPEEDS   4       // Viaje por defecto entre tramos, en múltiplos de la velocidad
+#define NETWORK_HORIZON         3600    // Segundos virtuales que dura la corrida por defecto
+
+/**
+ * @brief Un vehículo que pasa de un tramo a otro.
+ */
+typedef struct {
+    long long time;     /**< Instante de llegada a la cola de destino (us) */
+    long long origin;   /**< Instante en que entró a la red (us) */
+    int segment;        /**< Tramo de destino */
+    int side;           /**< Cola de destino */
+} Transfer;
+
+/**
+ * @brief Canal de traspasos de una partición a otra (un productor, un consumidor).
+ */
+typedef struct {
+    ATOMIC_INT head;            /**< Próximo a leer, lo mueve el consumidor */
+    char pad0[CACHE_LINE_SIZE - sizeof(ATOMIC_INT)];
+    ATOMIC_INT tail;            /**< Próximo a escribir, lo mueve el productor */
+    char pad1[CACHE_LINE_SIZE - sizeof(ATOMIC_INT)];
+    Transfer *slots;            /**< Arreglo circular */
+    int mask;                   /**< Capacidad - 1 */
+} __attribute__((aligned(CACHE_LINE_SIZE))) Channel;
+
+struct Red;
+
+/**
+ * @brief Un tramo de la red.
+ */
+typedef struct {
+    char name[FACILITY_NAME_SIZE];  /**< Nombre en el archivo */
+    int route[3];                   /**< Tramo siguiente según el lado del que vino el vehículo (-1: sale) */
+    long long travel;               /**< Viaje hasta el tramo siguiente (us) */
+    int partition;                  /**< Partición que lo corre */
+    long long sent;                 /**< Vehículos enviados a otros tramos */
+    long long exits;                /**< Vehículos que salieron de la red por este tramo */
+    struct Red *net;                /**< Red a la que pertenece */
+    Simulacion sim;                 /**< Estado propio del tramo */
+} __attribute__((aligned(CACHE_LINE_SIZE))) NetworkSegment;
+
+/**
+ * @brief Una partición: un hilo y un bloque contiguo de tramos.
+ */
+typedef struct {
+    ATOMIC_LLONG nextTime;          /**< Menor instante pendiente, publicado en cada ventana */
+    char pad[CACHE_LINE_SIZE - sizeof(ATOMIC_LLONG)];
+    struct Red *net;                /**< Red */
+    int index;                      /**< Número de partición */
+    int first, last;                /**< Tramos [first, last) */
+    pthread_t thread;               /**< Hilo */
+    long long windows;              /**< Ventanas avanzadas */
+    Histogram networkTime;          /**< Tiempo en la red de los vehículos que salieron en esta partición */
+} __attribute__((aligned(CACHE_LINE_SIZE))) Partition;
+
+/**
+ * @brief Barrera por espera activa; quien espera sigue vaciando sus canales.
+ */
+typedef struct {
+    ATOMIC_INT count;               /**< Hilos que llegaron en esta vuelta */
+    char pad0[CACHE_LINE_SIZE - sizeof(ATOMIC_INT)];
+    ATOMIC_INT generation;          /**< Vueltas completadas */
+    char pad1[CACHE_LINE_SIZE - sizeof(ATOMIC_INT)];
+    int parties;                    /**< Hilos que participan */
+} SpinBarrier;
+
+/**
+ * @brief La red completa.
+ */
+typedef struct Red {
+    NetworkSegment *segments;       /**< Tramos, en el orden del archivo */
+    int count;                      /**< Cantidad de tramos */
+    Partition *parts;               /**< Particiones */
+    int partCount;                  /**< Cantidad de particiones */
+    Channel *channels;              /**< Canal de la partición i a la j en [i * partCount + j] */
+    SpinBarrier barrier;            /**< Fin de cada ventana */
+    long long lookahead;            /**< Menor viaje entre tramos (us) */
+    long long horizon;              /**< Instante virtual en que termina la corrida (us) */
+} Red;
+
+
+/**
+ * @brief Lee el archivo de la red e inicializa una simulación por tramo.
+ *
+ * @param net Red a inicializar
+ * @param base Parámetros de partida de todos los tramos
+ * @param path Ruta del archivo
+ * @return 0 si todo salió bien, -1 si no se pudo leer, es inválido (el error se informa en stderr) o no hubo
+ * memoria
+ */
+int loadNetwork(Red *net, const SimParams *base, const char *path);
+
+
+/**
+ * @brief Corre la red hasta el horizonte y espera a que termine.
+ *
+ * @param net Red cargada
+ * @param threads Particiones (hilos) a usar; 0 o menos: una por procesador, nunca más que tramos
+ * @param horizon Segundos virtuales a simular
+ * @return 0 si todo salió bien, -1 si no hubo memoria o no se pudieron crear los hilos
+ */
+int runNetwork(Red *net, int threads, double horizon);
+
+
+/**
+ * @brief Imprime una fila por tramo, los totales y el tiempo en la red de los vehículos que salieron.
+ *
+ * @param net Red terminada
+ * @param out Archivo de salida
+ * @param wallSeconds Tiempo real que tomó la corrida
+ */
+void printNetworkSummary(const Red *net, FILE *out, double wallSeconds);
+
+
+/**
+ * @brief Libera la memoria de la red.
+ *
+ * @param net Red
+ */
+void freeNetwork(Red *net);
+
+
+#endif
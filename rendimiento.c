@@ -0,0 +1,383 @@
+/**
+ * @file rendimiento.c
+ * @brief Microbenchmarks de los buffers y pruebas de carga sin pantalla (make bench).
+ *
+ * @details
+ * Dos capas, las dos escriben CSV en formato largo (una métrica por fila) para poder comparar corridas con
+ * diff o cargarlas en una planilla:
+ *
+ *     capa,prueba,tamano,hilos,metrica,valor
+ *
+ *  - micro: createBuffer/destroyBuffer, addToBuffer/removeFromBuffer, countBuffer, isBufferEmpty y las
+ *    operaciones en bloque, con distintos tamaños de buffer; y el par añadir/retirar protegido por un
+ *    semáforo, como las colas del puente, con 1 a BENCH_MAX_THREADS hilos, midiendo además cuánto espera
+ *    cada operación por el semáforo. También la cola sin bloqueo con un productor y un consumidor.
+ *  - carga: la simulación de eventos discretos con cada política, modo y carga de llegadas: vehículos por
+ *    segundo (simulados), eventos por segundo (reales), la distribución de vehículos que encuentra cada
+ *    llegada en su cola y la espera máxima por lado, que es la cota de inanición observada.
+ *
+ * La cantidad de operaciones se escala con -x para corridas más cortas o más largas.
+ *
+ * @date 16 de octubre de 2026 (creación)
+ * @version 1.0
+ * @authors
+ * Julio López
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <semaphore.h>
+#include <time.h>
+#include "funciones.h"
+#include "simulacion.h"
+
+#define BENCH_OPS           (1 << 20)   // Operaciones por prueba de la capa micro (con -x 1)
+#define BENCH_CREATES       (1 << 12)   // createBuffer/destroyBuffer por tamaño
+#define BENCH_MAX_THREADS   8
+#define BENCH_BATCH         16          // Valores por operación en bloque
+#define BENCH_VEHICLES      200000      // Vehículos por corrida de la capa de carga (con -x 1)
+#define BENCH_SPEED         250000      // Velocidad del puente de las corridas de carga (la de main)
+
+static const int benchSizes[] = {16, 256, INT_RING_CAPACITY};     // Hasta la capacidad del buffer
+#define BENCH_SIZE_COUNT    ((int)(sizeof(benchSizes) / sizeof(benchSizes[0])))
+
+static volatile long long sink;     // Evita que el compilador descarte las lecturas medidas.
+
+static long long nowNs() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+static void row(const char *layer, const char *test, int size, int threads, const char *metric, double value) {
+    printf("%s,%s,%d,%d,%s,%.4f\n", layer, test, size, threads, metric, value);
+}
+
+// Fila de nanosegundos por operación y operaciones por segundo.
+static void rateRows(const char *test, int size, int threads, long long ops, long long ns) {
+    row("micro", test, size, threads, "ns_por_op", (double)ns / ops);
+    row("micro", test, size, threads, "ops_por_s", ops * 1e9 / ns);
+}
+
+/**************************************
+ *      *CAPA MICRO
+ *************************************/
+
+static void benchCreate(int size) {
+    long long start = nowNs();
+    for (int i = 0; i < BENCH_CREATES; i++) {
+        destroyBuffer(createBuffer(size));
+    }
+    rateRows("create_destroy", size, 1, BENCH_CREATES, nowNs() - start);
+}
+
+static void benchSingle(int size, long long ops) {
+    CircularBuffer *cb = createBuffer(size);
+    long long rounds = ops / size + 1;
+    long long start = nowNs();
+    for (long long r = 0; r < rounds; r++) {
+        for (int i = 0; i < size; i++) {
+            addToBuffer(cb, i + 1);
+        }
+        for (int i = 0; i < size; i++) {
+            sink += removeFromBuffer(cb);
+        }
+    }
+    rateRows("add_remove", size, 1, 2 * rounds * size, nowNs() - start);
+
+    // Medio lleno, para que las lecturas no sean el caso trivial.
+    for (int i = 0; i < size / 2; i++) {
+        addToBuffer(cb, i + 1);
+    }
+    start = nowNs();
+    for (long long i = 0; i < ops; i++) {
+        sink += countBuffer(cb);
+    }
+    rateRows("count", size, 1, ops, nowNs() - start);
+    start = nowNs();
+    for (long long i = 0; i < ops; i++) {
+        sink += isBufferEmpty(cb);
+    }
+    rateRows("is_empty", size, 1, ops, nowNs() - start);
+    destroyBuffer(cb);
+}
+
+static void benchBulk(int size, long long ops) {
+    CircularBuffer *cb = createBuffer(size);
+    int values[BENCH_BATCH];
+    int batch = (size < BENCH_BATCH) ? size : BENCH_BATCH;
+    for (int i = 0; i < batch; i++) {
+        values[i] = i + 1;
+    }
+    long long moved = 0;
+    long long start = nowNs();
+    // Un tercio de la capacidad ocupada, así las copias dan la vuelta del arreglo.
+    for (int i = 0; i < size / 3; i++) {
+        addToBuffer(cb, i + 1);
+    }
+    while (moved < ops) {
+        moved += addManyToBuffer(cb, values, batch);
+        moved += removeManyFromBuffer(cb, values, batch);
+    }
+    rateRows("add_remove_many", size, 1, moved, nowNs() - start);
+    destroyBuffer(cb);
+}
+
+/**
+ * @brief Estado compartido de la prueba con varios hilos sobre un buffer protegido por un semáforo.
+ */
+typedef struct {
+    CircularBuffer *cb;
+    sem_t lock;
+    long long ops;          /**< Operaciones por hilo */
+} LockedBench;
+
+/**
+ * @brief Resultado de un hilo, en su propia línea de caché.
+ */
+typedef struct {
+    LockedBench *bench;
+    long long waitNs;       /**< Tiempo total esperando el semáforo */
+    pthread_t thread;
+} __attribute__((aligned(CACHE_LINE_SIZE))) LockedWorker;
+
+static void* lockedLoop(void *arg) {
+    LockedWorker *w = (LockedWorker*)arg;
+    LockedBench *b = w->bench;
+    for (long long i = 0; i < b->ops; i++) {
+        long long before = nowNs();
+        sem_wait(&b->lock);
+        w->waitNs += nowNs() - before;
+        addToBuffer(b->cb, 1);
+        sink += removeFromBuffer(b->cb);
+        sem_post(&b->lock);
+    }
+    return NULL;
+}
+
+static void benchLocked(int size, int threads, long long ops) {
+    LockedBench b;
+    LockedWorker *workers;
+    if (posix_memalign((void**)&workers, CACHE_LINE_SIZE, threads * sizeof(LockedWorker)) != 0) {
+        return;
+    }
+    memset(workers, 0, threads * sizeof(LockedWorker));
+    b.cb = createBuffer(size);
+    b.ops = ops / threads;
+    sem_init(&b.lock, 0, 1);
+
+    long long start = nowNs();
+    for (int t = 0; t < threads; t++) {
+        workers[t].bench = &b;
+        pthread_create(&workers[t].thread, NULL, lockedLoop, &workers[t]);
+    }
+    long long waitNs = 0;
+    for (int t = 0; t < threads; t++) {
+        pthread_join(workers[t].thread, NULL);
+        waitNs += workers[t].waitNs;
+    }
+    long long elapsed = nowNs() - start;
+    long long total = b.ops * threads;
+    rateRows("locked_add_remove", size, threads, total, elapsed);
+    row("micro", "locked_add_remove", size, threads, "espera_bloqueo_ns_por_op", (double)waitNs / total);
+
+    sem_destroy(&b.lock);
+    destroyBuffer(b.cb);
+    free(workers);
+}
+
+/**
+ * @brief Estado de la prueba de un productor y un consumidor sobre la cola sin bloqueo.
+ */
+typedef struct {
+    SpscBuffer *sb;
+    long long ops;
+} SpscBench;
+
+static void* spscProducer(void *arg) {
+    SpscBench *b = (SpscBench*)arg;
+    for (long long i = 0; i < b->ops; i++) {
+        while (!spscAdd(b->sb, 1)) {
+            sched_yield();
+        }
+    }
+    return NULL;
+}
+
+static void benchSpsc(int size, long long ops) {
+    SpscBench b = {createSpscBuffer(size), ops};
+    pthread_t producer;
+    long long start = nowNs();
+    pthread_create(&producer, NULL, spscProducer, &b);
+    for (long long i = 0; i < ops; i++) {
+        int value;
+        while ((value = spscRemove(b.sb)) == 0) {
+            sched_yield();
+        }
+        sink += value;
+    }
+    pthread_join(producer, NULL);
+    rateRows("spsc_transfer", size, 2, ops, nowNs() - start);
+    destroySpscBuffer(b.sb);
+}
+
+static void runMicro(double scale) {
+    long long ops = (long long)(BENCH_OPS * scale);
+    if (ops < 1) {
+        ops = 1;
+    }
+    for (int i = 0; i < BENCH_SIZE_COUNT; i++) {
+        int size = benchSizes[i];
+        benchCreate(size);
+        benchSingle(size, ops);
+        benchBulk(size, ops);
+        for (int threads = 1; threads <= BENCH_MAX_THREADS; threads *= 2) {
+            benchLocked(size, threads, ops);
+        }
+        benchSpsc(size, ops);
+        fflush(stdout);
+    }
+}
+
+/**************************************
+ *      *CAPA DE CARGA
+ *************************************/
+
+// Los mismos valores por defecto que main.
+static void loadParams(SimParams *p, PolicyKind policy, int pipelined, long long vehicles) {
+    memset(p, 0, sizeof(SimParams));
+    p->bufferSize = 20;
+    p->parkingSize = 10;
+    p->windowSize = 3;
+    p->parkingSpeed = BENCH_SPEED;
+    p->arrivalMin[1] = 2 * BENCH_SPEED;
+    p->arrivalSpread[1] = 7 * BENCH_SPEED;
+    p->arrivalMin[2] = 2 * BENCH_SPEED;
+    p->arrivalSpread[2] = 5 * BENCH_SPEED;
+    p->arrival = ARRIVAL_UNIFORM;
+    p->gates = 1;
+    p->weights.focusWeight = 4;
+    p->weights.otherWeight = 1;
+    p->weights.divisor = 1;
+    p->weights.maxWindow = pipelined ? p->bufferSize : p->parkingSize;
+    p->policy = policy;
+    p->admitTimeout = BENCH_SPEED / 2;
+    p->pipelined = pipelined;
+    p->maxVehicles = vehicles;
+    p->seed = 1;
+}
+
+/**
+ * @brief Una carga de llegadas: espera mínima y dispersión por lado en múltiplos de la velocidad.
+ */
+typedef struct {
+    const char *name;
+    int min[3];
+    int spread[3];
+    ArrivalKind arrival;
+} LoadCase;
+
+static const LoadCase loadCases[] = {
+    {"base", {0, 2, 2}, {0, 7, 5}, ARRIVAL_UNIFORM},
+    {"izquierda_pesada", {0, 1, 3}, {0, 2, 8}, ARRIVAL_UNIFORM},
+    {"rafagas", {0, 2, 2}, {0, 7, 5}, ARRIVAL_BURSTY},
+};
+#define LOAD_CASE_COUNT     ((int)(sizeof(loadCases) / sizeof(loadCases[0])))
+
+static void runLoad(double scale) {
+    static const PolicyKind policies[] = {POLICY_HEURISTIC, POLICY_MAX_PRESSURE, POLICY_OLDEST, POLICY_EWMA};
+    long long vehicles = (long long)(BENCH_VEHICLES * scale);
+    char test[96];
+
+    for (int c = 0; c < LOAD_CASE_COUNT; c++) {
+        for (size_t k = 0; k < sizeof(policies) / sizeof(policies[0]); k++) {
+            for (int pipelined = 0; pipelined <= 1; pipelined++) {
+                SimParams p;
+                Simulacion sim;
+                loadParams(&p, policies[k], pipelined, vehicles);
+                p.arrival = loadCases[c].arrival;
+                for (int side = 1; side <= 2; side++) {
+                    p.arrivalMin[side] = loadCases[c].min[side] * BENCH_SPEED;
+                    p.arrivalSpread[side] = loadCases[c].spread[side] * BENCH_SPEED;
+                }
+                if (initSimulation(&sim, &p) != 0) {
+                    fprintf(stderr, "No se pudo inicializar la simulación\n");
+                    continue;
+                }
+                long long start = nowNs();
+                while (stepSimulation(&sim, 1 << 16)) {
+                }
+                double wall = (nowNs() - start) / 1e9;
+                double simulated = sim.now / 1e6;
+
+                snprintf(test, sizeof(test), "%s-%s-%s", loadCases[c].name, policyName(policies[k]),
+                         pipelined ? "tuberia" : "lotes");
+                row("carga", test, p.bufferSize, 1, "vehiculos_por_s",
+                    (simulated > 0) ? sim.contador_out / simulated : 0);
+                row("carga", test, p.bufferSize, 1, "eventos_por_s", (wall > 0) ? sim.eventsProcessed / wall : 0);
+                for (int side = 1; side <= 2; side++) {
+                    const char *suffix = (side == 1) ? "izq" : "der";
+                    const Histogram *depth = &sim.queueDepth[side];
+                    const Histogram *wait = &sim.latency[side].wait;
+                    char metric[48];
+                    snprintf(metric, sizeof(metric), "cola_p50_%s", suffix);
+                    row("carga", test, p.bufferSize, 1, metric, histPercentile(depth, 50));
+                    snprintf(metric, sizeof(metric), "cola_p90_%s", suffix);
+                    row("carga", test, p.bufferSize, 1, metric, histPercentile(depth, 90));
+                    snprintf(metric, sizeof(metric), "cola_p99_%s", suffix);
+                    row("carga", test, p.bufferSize, 1, metric, histPercentile(depth, 99));
+                    snprintf(metric, sizeof(metric), "cola_max_%s", suffix);
+                    row("carga", test, p.bufferSize, 1, metric, depth->max);
+                    snprintf(metric, sizeof(metric), "rechazos_%s", suffix);
+                    row("carga", test, p.bufferSize, 1, metric, sim.rejected[side]);
+                    snprintf(metric, sizeof(metric), "espera_p99_s_%s", suffix);
+                    row("carga", test, p.bufferSize, 1, metric, histPercentile(wait, 99) / 1e6);
+                    snprintf(metric, sizeof(metric), "espera_max_s_%s", suffix);
+                    row("carga", test, p.bufferSize, 1, metric, wait->max / 1e6);
+                }
+                freeSimulation(&sim);
+                fflush(stdout);
+            }
+        }
+    }
+}
+
+static void usage(const char *prog) {
+    fprintf(stderr, "Uso: %s [-m | -c] [-x escala]\n", prog);
+    fprintf(stderr, "  -m         Solo la capa micro\n");
+    fprintf(stderr, "  -c         Solo la capa de carga\n");
+    fprintf(stderr, "  -x escala  Multiplica las operaciones y los vehículos de cada prueba (por defecto 1)\n");
+}
+
+int main(int argc, char *argv[]) {
+    int micro = 1;
+    int load = 1;
+    double scale = 1.0;
+    int opt;
+    while ((opt = getopt(argc, argv, "mcx:")) != -1) {
+        switch (opt) {
+        case 'm': load = 0; break;
+        case 'c': micro = 0; break;
+        case 'x': scale = atof(optarg); break;
+        default:
+            usage(argv[0]);
+            return 1;
+        }
+    }
+    if (scale <= 0) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    printf("capa,prueba,tamano,hilos,metrica,valor\n");
+    if (micro) {
+        runMicro(scale);
+    }
+    if (load) {
+        runLoad(scale);
+    }
+    return 0;
+}
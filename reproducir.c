@@ -0,0 +1,280 @@
+/**
+ * @file reproducir.c
+ * @brief Reproduce una traza binaria en pantalla y calcula estadísticas de la corrida.
+ *
+ * @details
+ * Lee un archivo escrito con "main -T archivo". Sin opciones reproduce la corrida en la vista de ncurses a la
+ * velocidad original; con -x se acelera o frena (0 reproduce sin esperas) y con -e solo se calculan las
+ * estadísticas, sin pantalla. Al final se imprime un resumen: eventos por código, vehículos cruzados,
+ * rechazos, cambios de dirección, ventana promedio y las latencias por lado reconstruidas a partir de los
+ * identificadores de los vehículos.
+ *
+ * @date 16 de octubre de 2026 (creación)
+ * @version 1.0
+ * @authors
+ * Julio López
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <time.h>
+#include <curses.h>
+#include "traza.h"
+#include "estadisticas.h"
+
+#define SEEN_SIZE       (1 << 16)   // Vehículos en vuelo recordados por lado
+#define REPLAY_LINES    MESSAGE_BUFFER_SIZE
+
+/**
+ * @brief Tiempos de un vehículo visto en la traza.
+ */
+typedef struct {
+    int id;                 /**< Identificador, 0 si el espacio está libre */
+    long long arrival;      /**< Instante del evento 'l' / 'r' */
+    long long dequeued;     /**< Instante del evento 'a' / 'b' */
+} SeenVehicle;
+
+/**
+ * @brief Estado reconstruido y estadísticas acumuladas.
+ */
+typedef struct {
+    const TraceHeader *h;
+    int queued[3];              /**< Vehículos en cada cola */
+    int crossing;               /**< Vehículos en el puente */
+    int dir;                    /**< Última dirección */
+    int window;                 /**< Última ventana */
+    long long codes[128];       /**< Eventos por código */
+    long long crossed[3];       /**< Vehículos que cruzaron por lado */
+    long long flips;            /**< Cambios de dirección */
+    long long batches;          /**< Lotes (ventanas) observados */
+    long long windowSum;        /**< Suma de la ventana de cada lote */
+    long long firstTime, lastTime;
+    SeenVehicle *seen[3];       /**< Vehículos vistos por lado, indexados por secuencia */
+    LatencyStats latency[3];    /**< Latencias por lado */
+} ReplayState;
+
+static SeenVehicle* seenSlot(ReplayState *st, int id) {
+    int side = vehicleSide(id);
+    return &st->seen[side][((id - 1) >> 1) & (SEEN_SIZE - 1)];
+}
+
+// Actualiza el estado con un registro. Las latencias solo se registran si se vio la llegada del vehículo,
+// así una traza que dio la vuelta no produce tiempos inventados.
+static void applyRecord(ReplayState *st, const TraceRecord *r) {
+    SeenVehicle *v = (r->vehicle > 0) ? seenSlot(st, r->vehicle) : NULL;
+    int known = (v != NULL && v->id == r->vehicle);
+    int side = (r->vehicle > 0) ? vehicleSide(r->vehicle) : 0;
+
+    st->codes[(int)r->code & 127]++;
+    if (r->dir != 0 && r->dir != st->dir) {
+        if (st->dir != 0) {
+            st->flips++;
+        }
+        st->batches++;
+        st->windowSum += r->window;
+    }
+    st->dir = r->dir;
+    st->window = r->window;
+    st->lastTime = r->time;
+
+    switch (r->code) {
+    case 'l':
+    case 'r':
+        st->queued[(r->code == 'l') ? 1 : 2]++;
+        if (v != NULL) {
+            v->id = r->vehicle;
+            v->arrival = r->time;
+            v->dequeued = r->time;
+        }
+        break;
+    case 'a':
+    case 'b':
+        if (st->queued[(r->code == 'a') ? 1 : 2] > 0) {
+            st->queued[(r->code == 'a') ? 1 : 2]--;
+        }
+        if (known) {
+            v->dequeued = r->time;
+            histRecord(&st->latency[side].wait, r->time - v->arrival);
+        }
+        break;
+    case 'A':
+    case 'B':
+        st->crossing++;
+        break;
+    case 'O':
+        if (r->vehicle > 0) {
+            if (st->crossing > 0) {
+                st->crossing--;
+            }
+            st->crossed[side]++;
+            if (known) {
+                histRecord(&st->latency[side].bridge, r->time - v->dequeued);
+                histRecord(&st->latency[side].total, r->time - v->arrival);
+                v->id = 0;
+            }
+        }
+        break;
+    default:
+        break;
+    }
+}
+
+static void appendCount(char *line, int *len, int size, int n, int towardsRight) {
+    for (int i = 0; i < size; i++) {
+        int occupied = towardsRight ? (i >= size - n) : (i < n);
+        line[(*len)++] = occupied ? OCCUPIED_CHAR : EMPTY_CHAR;
+    }
+    line[*len] = '\0';
+}
+
+static void drawState(const ReplayState *st, const TraceRecord *r, char messages[][256], int *messageIndex) {
+    char line[512];
+    int len;
+    int bufferSize = (st->h->bufferSize < 64) ? st->h->bufferSize : 64;
+    int parkingSize = (st->h->parkingSize < 64) ? st->h->parkingSize : 64;
+
+    len = snprintf(line, sizeof(line), "T:%10.4fs  Dir:%d  Window:%2d  Cruzando:%2d  Done:%5lld   Wait:%2d ",
+                   r->time / 1e6, st->dir, st->window, st->crossing,
+                   st->crossed[1] + st->crossed[2], st->queued[1]);
+    appendCount(line, &len, bufferSize, st->queued[1], 1);
+    len += snprintf(line + len, sizeof(line) - len, "   ");
+    appendCount(line, &len, parkingSize, st->crossing, st->dir == 1);
+    len += snprintf(line + len, sizeof(line) - len, "   ");
+    appendCount(line, &len, bufferSize, st->queued[2], 0);
+    snprintf(line + len, sizeof(line) - len, " Wait:%2d", st->queued[2]);
+    mvprintw(0, 0, "%s", line);
+    clrtoeol();
+
+    snprintf(messages[*messageIndex], 256, "%s (vehículo %d)", eventMessage(r->code), r->vehicle);
+    *messageIndex = (*messageIndex + 1) % REPLAY_LINES;
+    for (int i = 0; i < REPLAY_LINES; i++) {
+        mvprintw(2 + i, 0, "%s", messages[(*messageIndex + i) % REPLAY_LINES]);
+        clrtoeol();
+    }
+    refresh();
+}
+
+static void printSummary(const ReplayState *st, long long first, long long end, FILE *out) {
+    double span = (st->lastTime - st->firstTime) / 1e6;
+    long long crossed = st->crossed[1] + st->crossed[2];
+
+    fprintf(out, "Traza: registros %lld a %lld", first, end);
+    if (first > 0) {
+        fprintf(out, " (se perdieron los %lld más antiguos)", first);
+    }
+    fprintf(out, "\n");
+    fprintf(out, "  Puente %d espacios, colas %d, velocidad %d us, modo %s\n", st->h->parkingSize,
+            st->h->bufferSize, st->h->parkingSpeed, st->h->pipelined ? "tubería" : "lotes");
+    fprintf(out, "  Duración:             %.3f s\n", span);
+    fprintf(out, "  Vehículos cruzados:   %lld (izquierda %lld, derecha %lld)\n", crossed, st->crossed[1],
+            st->crossed[2]);
+    fprintf(out, "  Llegadas:             izquierda %lld (rechazadas %lld), derecha %lld (rechazadas %lld)\n",
+            st->codes['l'], st->codes['L'], st->codes['r'], st->codes['R']);
+    fprintf(out, "  Cambios de dirección: %lld\n", st->flips);
+    if (st->batches > 0) {
+        fprintf(out, "  Ventana promedio:     %.2f\n", (double)st->windowSum / st->batches);
+    }
+    if (span > 0) {
+        fprintf(out, "  Throughput:           %.4f vehículos/s\n", crossed / span);
+    }
+    fprintf(out, "  Eventos:");
+    for (int c = 0; c < 128; c++) {
+        if (st->codes[c] > 0) {
+            fprintf(out, " %c=%lld", c, st->codes[c]);
+        }
+    }
+    fprintf(out, "\n");
+    printLatencyReport(out, st->latency);
+}
+
+static void waitMicroseconds(long long us) {
+    struct timespec ts;
+    ts.tv_sec = us / 1000000;
+    ts.tv_nsec = (us % 1000000) * 1000;
+    nanosleep(&ts, NULL);
+}
+
+static void usage(const char *prog) {
+    fprintf(stderr, "Uso: %s [-e] [-x velocidad] archivo\n", prog);
+    fprintf(stderr, "  -e            Solo estadísticas, sin pantalla\n");
+    fprintf(stderr, "  -x velocidad  Factor de velocidad de la reproducción (por defecto 1, 0: sin esperas)\n");
+}
+
+int main(int argc, char *argv[]) {
+    int statsOnly = 0;
+    double speed = 1.0;
+    int opt;
+    while ((opt = getopt(argc, argv, "ex:")) != -1) {
+        switch (opt) {
+        case 'e': statsOnly = 1; break;
+        case 'x': speed = atof(optarg); break;
+        default:
+            usage(argv[0]);
+            return 1;
+        }
+    }
+    if (optind >= argc) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    TraceFile tf;
+    if (openTraceReader(&tf, argv[optind]) != 0) {
+        fprintf(stderr, "%s: no es una traza válida\n", argv[optind]);
+        return 1;
+    }
+
+    ReplayState st;
+    memset(&st, 0, sizeof(st));
+    st.h = tf.header;
+    for (int side = 1; side <= 2; side++) {
+        st.seen[side] = calloc(SEEN_SIZE, sizeof(SeenVehicle));
+        if (st.seen[side] == NULL) {
+            fprintf(stderr, "Sin memoria\n");
+            return 1;
+        }
+        latencyInit(&st.latency[side]);
+    }
+
+    long long first = traceFirst(&tf);
+    long long end = traceEnd(&tf);
+    char messages[REPLAY_LINES][256];
+    int messageIndex = 0;
+    memset(messages, 0, sizeof(messages));
+    if (!statsOnly) {
+        initscr();
+        cbreak();
+        noecho();
+        curs_set(FALSE);
+    }
+
+    long long previous = -1;
+    for (long long pos = first; pos < end; pos++) {
+        const TraceRecord *r = traceAt(&tf, pos);
+        if (r->code == 0) {
+            continue;   // Registro incompleto: la corrida terminó mientras se escribía.
+        }
+        if (previous < 0) {
+            st.firstTime = r->time;
+        }
+        if (!statsOnly && speed > 0 && previous >= 0 && r->time > previous) {
+            waitMicroseconds((long long)((r->time - previous) / speed));
+        }
+        previous = r->time;
+        applyRecord(&st, r);
+        if (!statsOnly) {
+            drawState(&st, r, messages, &messageIndex);
+        }
+    }
+
+    if (!statsOnly) {
+        endwin();
+    }
+    printSummary(&st, first, end, stdout);
+    free(st.seen[1]);
+    free(st.seen[2]);
+    closeTrace(&tf);
+    return 0;
+}
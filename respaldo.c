@@ -0,0 +1,453 @@
+/**
+ * @file respaldo.c
+ * @brief Definiciones de los puntos de control de la simulación de eventos discretos.
+ *
+ * @details
+ * Orden del archivo: cabecera (CHECKPOINT_MAGIC, versión y tamaños), los campos de Simulacion en el orden de
+ * serializeSimulation() y una suma FNV-1a de 64 bits de todo lo anterior. Las colas se guardan por espacios
+ * lógicos desde tail, así que al cargarlas tail vuelve a 0 sin que cambie nada de lo que ve la simulación.
+ *
+ * @date 16 de octubre de 2026 (creación)
+ * @version 1.0
+ * @authors
+ * Julio López
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <errno.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <signal.h>
+#include "respaldo.h"
+
+/**************************************
+ *      *ESCRITURA EN MEMORIA
+ *************************************/
+
+static int put(CheckpointBuffer *b, const void *data, size_t n) {
+    if (b->size + n > b->capacity) {
+        size_t capacity = (b->capacity > 0) ? b->capacity : 4096;
+        while (capacity < b->size + n) {
+            capacity *= 2;
+        }
+        unsigned char *grown = realloc(b->data, capacity);
+        if (grown == NULL) {
+            return -1;
+        }
+        b->data = grown;
+        b->capacity = capacity;
+    }
+    memcpy(b->data + b->size, data, n);
+    b->size += n;
+    return 0;
+}
+
+#define PUT(b, value)   put(b, &(value), sizeof(value))
+
+static uint64_t fnv1a(const unsigned char *data, size_t n) {
+    uint64_t hash = 14695981039346656037ULL;
+    for (size_t i = 0; i < n; i++) {
+        hash = (hash ^ data[i]) * 1099511628211ULL;
+    }
+    return hash;
+}
+
+// Tamaño lógico, posición de head relativa a tail, ocupados y los "size" espacios lógicos.
+static int putBuffer(CheckpointBuffer *b, const CircularBuffer *r) {
+    unsigned head = r->head - r->tail;
+    int rc = PUT(b, r->size) | PUT(b, head) | PUT(b, r->count);
+    for (int i = 0; i < r->size; i++) {
+        int value = intRingAt(r, i);
+        rc |= PUT(b, value);
+    }
+    return rc;
+}
+
+// Solo los intervalos con registros, como pares (índice, conteo).
+static int putHistogram(CheckpointBuffer *b, const Histogram *h) {
+    int used = 0;
+    for (int i = 0; i < HIST_BUCKETS; i++) {
+        used += (h->buckets[i] != 0);
+    }
+    int rc = PUT(b, h->count) | PUT(b, h->sum) | PUT(b, h->max) | PUT(b, used);
+    for (int i = 0; i < HIST_BUCKETS; i++) {
+        if (h->buckets[i] != 0) {
+            rc |= PUT(b, i) | PUT(b, h->buckets[i]);
+        }
+    }
+    return rc;
+}
+
+static int putLatency(CheckpointBuffer *b, const LatencyStats *s) {
+    return putHistogram(b, &s->wait) | putHistogram(b, &s->bridge) | putHistogram(b, &s->total);
+}
+
+// Cabecera: firma, versión y tamaños de lo que se copia tal cual.
+static int putHeader(CheckpointBuffer *b) {
+    uint32_t header[7] = {CHECKPOINT_VERSION, sizeof(SimParams), sizeof(SimEvent), sizeof(SchedPolicy),
+                          sizeof(Rng), sizeof(VehicleTimes), HIST_BUCKETS};
+    return put(b, CHECKPOINT_MAGIC, 8) | put(b, header, sizeof(header));
+}
+
+int serializeSimulation(const Simulacion *sim, CheckpointBuffer *out) {
+    out->size = 0;
+    int rc = putHeader(out);
+    rc |= PUT(out, sim->p) | PUT(out, sim->now);
+    rc |= PUT(out, sim->events.count) | PUT(out, sim->events.nextSeq);
+    rc |= put(out, sim->events.heap, sim->events.count * sizeof(SimEvent));
+    rc |= putBuffer(out, sim->left) | putBuffer(out, sim->right);
+    rc |= putBuffer(out, sim->leftPriority) | putBuffer(out, sim->rightPriority);
+    rc |= putBuffer(out, sim->parking);
+    rc |= PUT(out, sim->dir) | PUT(out, sim->window) | PUT(out, sim->sched);
+    rc |= PUT(out, sim->batchIndex) | PUT(out, sim->moving) | PUT(out, sim->admitting);
+    rc |= PUT(out, sim->waitingSide) | PUT(out, sim->waitToken) | PUT(out, sim->running);
+    rc |= PUT(out, sim->priorityStreak);
+    rc |= put(out, sim->rng, (1 + 2 * sim->p.gates) * sizeof(Rng));
+    rc |= PUT(out, sim->contador_out) | PUT(out, sim->arrivals) | PUT(out, sim->rejected);
+    rc |= PUT(out, sim->admitted) | PUT(out, sim->exited) | PUT(out, sim->initialFill);
+    rc |= PUT(out, sim->flips) | PUT(out, sim->preemptions);
+    rc |= PUT(out, sim->eventsProcessed) | PUT(out, sim->transfers);
+    for (int side = 1; side <= 2; side++) {
+        const VehicleTable *t = &sim->vehicles[side];
+        rc |= PUT(out, t->mask) | PUT(out, t->nextSeq) | PUT(out, t->committed);
+        rc |= put(out, t->slots, (t->mask + 1) * sizeof(VehicleTimes));
+        rc |= putLatency(out, &sim->latency[side]) | putLatency(out, &sim->priorityLatency[side]);
+        rc |= putHistogram(out, &sim->queueDepth[side]);
+    }
+    uint64_t sum = fnv1a(out->data, out->size);
+    rc |= PUT(out, sum);
+    return (rc != 0) ? -1 : 0;
+}
+
+/**************************************
+ *      *LECTURA
+ *************************************/
+
+typedef struct {
+    const unsigned char *data;
+    size_t size;
+    size_t pos;
+    int bad;        // 1 si se intentó leer más allá del final
+} Reader;
+
+static void get(Reader *r, void *dst, size_t n) {
+    if (r->bad || n > r->size - r->pos) {
+        r->bad = 1;
+        memset(dst, 0, n);
+        return;
+    }
+    memcpy(dst, r->data + r->pos, n);
+    r->pos += n;
+}
+
+#define GET(r, value)   get(r, &(value), sizeof(value))
+
+static CircularBuffer* getBuffer(Reader *r) {
+    int size, count;
+    unsigned head;
+    GET(r, size);
+    GET(r, head);
+    GET(r, count);
+    if (r->bad || size < 1 || head >= (unsigned)size || count < 0 || count > size) {
+        r->bad = 1;
+        return NULL;
+    }
+    CircularBuffer *b = createBuffer(size);
+    if (b == NULL) {
+        return NULL;
+    }
+    for (int i = 0; i < size; i++) {
+        GET(r, b->slots[i]);
+    }
+    b->head = head;
+    b->count = count;
+    return b;
+}
+
+static void getHistogram(Reader *r, Histogram *h) {
+    int used;
+    histInit(h);
+    GET(r, h->count);
+    GET(r, h->sum);
+    GET(r, h->max);
+    GET(r, used);
+    for (int k = 0; k < used && !r->bad; k++) {
+        int i;
+        GET(r, i);
+        if (i < 0 || i >= HIST_BUCKETS) {
+            r->bad = 1;
+            return;
+        }
+        GET(r, h->buckets[i]);
+    }
+}
+
+static void getLatency(Reader *r, LatencyStats *s) {
+    getHistogram(r, &s->wait);
+    getHistogram(r, &s->bridge);
+    getHistogram(r, &s->total);
+}
+
+static int readFile(const char *path, unsigned char **data, size_t *size) {
+    FILE *in = fopen(path, "rb");
+    if (in == NULL) {
+        return -1;
+    }
+    size_t capacity = 65536;
+    *size = 0;
+    *data = malloc(capacity);
+    while (*data != NULL) {
+        *size += fread(*data + *size, 1, capacity - *size, in);
+        if (*size < capacity) {
+            break;
+        }
+        capacity *= 2;
+        unsigned char *grown = realloc(*data, capacity);
+        if (grown == NULL) {
+            free(*data);
+        }
+        *data = grown;
+    }
+    int noMemory = (*data == NULL);
+    int failed = ferror(in);
+    fclose(in);
+    if (noMemory || failed) {
+        free(*data);
+        errno = noMemory ? ENOMEM : EIO;
+        return -1;
+    }
+    return 0;
+}
+
+// Reconstruye la simulación; "bad" queda en 1 si el contenido no cierra.
+static void getSimulation(Reader *r, Simulacion *sim) {
+    char magic[8];
+    uint32_t header[7];
+    uint32_t expected[7] = {CHECKPOINT_VERSION, sizeof(SimParams), sizeof(SimEvent), sizeof(SchedPolicy),
+                            sizeof(Rng), sizeof(VehicleTimes), HIST_BUCKETS};
+    GET(r, magic);
+    GET(r, header);
+    if (r->bad || memcmp(magic, CHECKPOINT_MAGIC, 8) != 0 || memcmp(header, expected, sizeof(header)) != 0) {
+        r->bad = 1;
+        return;
+    }
+
+    GET(r, sim->p);
+    GET(r, sim->now);
+    GET(r, sim->events.count);
+    GET(r, sim->events.nextSeq);
+    if (r->bad || sim->p.gates < 1 || sim->events.count < 0 ||
+        (size_t)sim->events.count > (r->size - r->pos) / sizeof(SimEvent)) {
+        r->bad = 1;
+        return;
+    }
+    sim->events.capacity = (sim->events.count > 16) ? sim->events.count : 16;
+    sim->events.heap = malloc(sim->events.capacity * sizeof(SimEvent));
+    sim->rng = malloc((1 + 2 * sim->p.gates) * sizeof(Rng));
+    if (sim->events.heap == NULL || sim->rng == NULL) {
+        return;
+    }
+    get(r, sim->events.heap, sim->events.count * sizeof(SimEvent));
+
+    sim->left = getBuffer(r);
+    sim->right = getBuffer(r);
+    sim->leftPriority = getBuffer(r);
+    sim->rightPriority = getBuffer(r);
+    sim->parking = getBuffer(r);
+    GET(r, sim->dir);
+    GET(r, sim->window);
+    GET(r, sim->sched);
+    GET(r, sim->batchIndex);
+    GET(r, sim->moving);
+    GET(r, sim->admitting);
+    GET(r, sim->waitingSide);
+    GET(r, sim->waitToken);
+    GET(r, sim->running);
+    GET(r, sim->priorityStreak);
+    get(r, sim->rng, (1 + 2 * sim->p.gates) * sizeof(Rng));
+    GET(r, sim->contador_out);
+    GET(r, sim->arrivals);
+    GET(r, sim->rejected);
+    GET(r, sim->admitted);
+    GET(r, sim->exited);
+    GET(r, sim->initialFill);
+    GET(r, sim->flips);
+    GET(r, sim->preemptions);
+    GET(r, sim->eventsProcessed);
+    GET(r, sim->transfers);
+    for (int side = 1; side <= 2 && !r->bad; side++) {
+        VehicleTable *t = &sim->vehicles[side];
+        int mask, nextSeq;
+        long long committed;
+        GET(r, mask);
+        GET(r, nextSeq);
+        GET(r, committed);
+        if (r->bad || mask < 0 || (mask & (mask + 1)) != 0 || nextSeq < 0 || nextSeq > VEHICLE_SEQ_MASK ||
+            vehicleTableInit(t, side, mask + 1) != 0) {
+            r->bad = 1;
+            return;
+        }
+        t->nextSeq = nextSeq;
+        t->committed = committed;
+        get(r, t->slots, (mask + 1) * sizeof(VehicleTimes));
+        getLatency(r, &sim->latency[side]);
+        getLatency(r, &sim->priorityLatency[side]);
+        getHistogram(r, &sim->queueDepth[side]);
+    }
+}
+
+int loadCheckpoint(Simulacion *sim, const char *path) {
+    unsigned char *data;
+    size_t size;
+    if (readFile(path, &data, &size) != 0) {
+        return -1;
+    }
+    memset(sim, 0, sizeof(Simulacion));
+    uint64_t sum = 0;
+    Reader r = {data, size, 0, 0};
+    if (size >= sizeof(sum)) {
+        memcpy(&sum, data + size - sizeof(sum), sizeof(sum));
+        r.size -= sizeof(sum);
+    }
+    if (size < sizeof(sum) || fnv1a(data, r.size) != sum) {
+        r.bad = 1;
+    } else {
+        getSimulation(&r, sim);
+    }
+    free(data);
+
+    int complete = sim->events.heap != NULL && sim->rng != NULL && sim->left != NULL && sim->right != NULL &&
+                   sim->leftPriority != NULL && sim->rightPriority != NULL && sim->parking != NULL &&
+                   sim->vehicles[1].slots != NULL && sim->vehicles[2].slots != NULL;
+    if (r.bad || r.pos != r.size || !complete) {
+        freeSimulation(sim);
+        errno = (r.bad || r.pos != r.size) ? EINVAL : ENOMEM;
+        return -1;
+    }
+    sim->nextPeriodic = LLONG_MAX;
+    return 0;
+}
+
+/**************************************
+ *      *HILO DE ESCRITURA
+ *************************************/
+
+// Escribe la foto al temporal y lo renombra: el destino siempre tiene un punto de control completo.
+static int writeCheckpoint(const CheckpointWriter *cw) {
+    FILE *out = fopen(cw->tmpPath, "wb");
+    if (out == NULL) {
+        return errno;
+    }
+    int failed = fwrite(cw->buffer.data, 1, cw->buffer.size, out) != cw->buffer.size || fflush(out) != 0 ||
+                 fsync(fileno(out)) != 0;
+    int err = failed ? errno : 0;
+    if (fclose(out) != 0 && err == 0) {
+        err = errno;
+    }
+    if (err == 0 && rename(cw->tmpPath, cw->path) != 0) {
+        err = errno;
+    }
+    return err;
+}
+
+static void* checkpointThread(void *arg) {
+    CheckpointWriter *cw = (CheckpointWriter*)arg;
+    pthread_mutex_lock(&cw->mutex);
+    while (1) {
+        while (!cw->ready && !cw->closing) {
+            pthread_cond_wait(&cw->cond, &cw->mutex);
+        }
+        if (!cw->ready) {
+            break;
+        }
+        // Mientras ready es 1 nadie más toca el búfer: se escribe sin el mutex.
+        pthread_mutex_unlock(&cw->mutex);
+        int err = writeCheckpoint(cw);
+        pthread_mutex_lock(&cw->mutex);
+        if (err != 0) {
+            cw->failed = err;
+        } else {
+            cw->written++;
+        }
+        cw->ready = 0;
+        pthread_cond_broadcast(&cw->cond);
+    }
+    pthread_mutex_unlock(&cw->mutex);
+    return NULL;
+}
+
+int openCheckpointWriter(CheckpointWriter *cw, const char *path) {
+    memset(cw, 0, sizeof(CheckpointWriter));
+    cw->path = malloc(strlen(path) + 1);
+    cw->tmpPath = malloc(strlen(path) + 5);
+    if (cw->path == NULL || cw->tmpPath == NULL) {
+        free(cw->path);
+        free(cw->tmpPath);
+        return -1;
+    }
+    strcpy(cw->path, path);
+    sprintf(cw->tmpPath, "%s.tmp", path);
+    pthread_mutex_init(&cw->mutex, NULL);
+    pthread_cond_init(&cw->cond, NULL);
+    // El hilo nace con todas las señales bloqueadas: SIGINT y SIGTERM las atiende el hilo de control (control.h)
+    // y SIGUSR1 el que simula.
+    sigset_t all, old;
+    sigfillset(&all);
+    pthread_sigmask(SIG_BLOCK, &all, &old);
+    int created = pthread_create(&cw->thread, NULL, checkpointThread, cw);
+    pthread_sigmask(SIG_SETMASK, &old, NULL);
+    if (created != 0) {
+        pthread_mutex_destroy(&cw->mutex);
+        pthread_cond_destroy(&cw->cond);
+        free(cw->path);
+        free(cw->tmpPath);
+        return -1;
+    }
+    return 0;
+}
+
+int takeCheckpoint(CheckpointWriter *cw, const Simulacion *sim, int wait) {
+    pthread_mutex_lock(&cw->mutex);
+    while (wait && cw->ready) {
+        pthread_cond_wait(&cw->cond, &cw->mutex);
+    }
+    int busy = cw->ready;
+    if (busy) {
+        cw->skipped++;
+    }
+    pthread_mutex_unlock(&cw->mutex);
+    if (busy) {
+        return 0;
+    }
+
+    // El hilo está libre y no toca el búfer hasta que ready sea 1.
+    if (serializeSimulation(sim, &cw->buffer) != 0) {
+        pthread_mutex_lock(&cw->mutex);
+        cw->failed = ENOMEM;
+        pthread_mutex_unlock(&cw->mutex);
+        return 0;
+    }
+    pthread_mutex_lock(&cw->mutex);
+    cw->ready = 1;
+    pthread_cond_signal(&cw->cond);
+    pthread_mutex_unlock(&cw->mutex);
+    return 1;
+}
+
+int closeCheckpointWriter(CheckpointWriter *cw) {
+    pthread_mutex_lock(&cw->mutex);
+    cw->closing = 1;
+    pthread_cond_broadcast(&cw->cond);
+    pthread_mutex_unlock(&cw->mutex);
+    pthread_join(cw->thread, NULL);
+    pthread_mutex_destroy(&cw->mutex);
+    pthread_cond_destroy(&cw->cond);
+    free(cw->buffer.data);
+    free(cw->path);
+    free(cw->tmpPath);
+    cw->buffer.data = NULL;
+    cw->path = cw->tmpPath = NULL;
+    return cw->failed;
+}
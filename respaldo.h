@@ -0,0 +1,116 @@
+/**
+ * @file respaldo.h
+ * @brief Puntos de control de la simulación de eventos discretos: guardar el estado completo y retomarlo.
+ *
+ * @details
+ * Un punto de control es todo lo que hace falta para que la corrida siga exactamente igual: parámetros, reloj,
+ * eventos pendientes (entre ellos las próximas llegadas de cada puerta), colas, carriles y puente, el estado
+ * del lote y de la política, los generadores de cada flujo, la tabla de vehículos y los contadores e
+ * histogramas. Retomar un punto de control y correr hasta el mismo límite da el mismo resumen que la corrida
+ * sin cortar.
+ *
+ * La foto se toma entre dos eventos, en el mismo hilo que simula, copiando el estado a un búfer en memoria
+ * (decenas de KB). Escribirlo al disco lo hace un hilo aparte: primero a "archivo.tmp", fsync() y después
+ * rename(), así el archivo siempre tiene un punto de control entero aunque la corrida se corte a la mitad.
+ * Si cuando toca otra foto el hilo todavía escribe la anterior, esa foto se omite y la simulación no espera.
+ *
+ * El formato es binario y compacto: los histogramas guardan solo los intervalos con registros. La cabecera
+ * lleva los tamaños de las estructuras que se copian tal cual y al final va una suma de verificación, así se
+ * rechazan archivos de otra compilación o truncados. Solo se puede retomar con el mismo programa.
+ *
+ * @date 16 de octubre de 2026 (creación)
+ * @version 1.0
+ * @authors
+ * Julio López
+ */
+
+#ifndef RESPALDO_H
+#define RESPALDO_H
+
+#include <stddef.h>
+#include <pthread.h>
+#include "simulacion.h"
+
+#define CHECKPOINT_MAGIC    "PUENTEPC"
+#define CHECKPOINT_VERSION  4
+#define CHECKPOINT_INTERVAL 600         // Segundos virtuales entre puntos de control por defecto
+
+/**
+ * @brief Búfer en memoria con un punto de control serializado.
+ */
+typedef struct {
+    unsigned char *data;    /**< Bytes del punto de control */
+    size_t size;            /**< Bytes usados */
+    size_t capacity;        /**< Bytes reservados */
+} CheckpointBuffer;
+
+/**
+ * @brief Escritor de puntos de control con su hilo de fondo.
+ */
+typedef struct {
+    char *path;                 /**< Archivo de destino */
+    char *tmpPath;              /**< Archivo temporal, se renombra al terminar de escribir */
+    CheckpointBuffer buffer;    /**< Foto que se escribe; la llena la simulación solo mientras ready es 0 */
+    int ready;                  /**< 1 mientras el hilo tiene una foto por escribir */
+    int closing;                /**< 1 cuando el hilo debe terminar */
+    int failed;                 /**< errno de la última escritura fallida, 0 si no hubo */
+    long long written;          /**< Puntos de control escritos */
+    long long skipped;          /**< Fotos omitidas porque el hilo seguía escribiendo */
+    pthread_t thread;           /**< Hilo que escribe */
+    pthread_mutex_t mutex;      /**< Protege ready, closing y los contadores */
+    pthread_cond_t cond;        /**< Avisa de una foto nueva o de que el hilo terminó de escribir */
+} CheckpointWriter;
+
+
+/**
+ * @brief Serializa el estado de la simulación en un búfer.
+ *
+ * @param sim Simulación entre dos eventos
+ * @param out Búfer, se reutiliza entre llamadas
+ * @return 0 si todo salió bien, -1 si no hubo memoria
+ */
+int serializeSimulation(const Simulacion *sim, CheckpointBuffer *out);
+
+
+/**
+ * @brief Reconstruye una simulación desde un punto de control. La traza y el aviso de salida (trace, onExit)
+ * quedan en NULL y no hay avisos periódicos.
+ *
+ * @param sim Simulación a inicializar
+ * @param path Archivo del punto de control
+ * @return 0 si todo salió bien, -1 si no (errno indica la causa; EINVAL si el archivo no es válido)
+ */
+int loadCheckpoint(Simulacion *sim, const char *path);
+
+
+/**
+ * @brief Crea el escritor y lanza su hilo.
+ *
+ * @param cw Escritor a inicializar
+ * @param path Archivo de destino
+ * @return 0 si todo salió bien, -1 si no
+ */
+int openCheckpointWriter(CheckpointWriter *cw, const char *path);
+
+
+/**
+ * @brief Toma una foto y se la pasa al hilo de fondo.
+ *
+ * @param cw Escritor
+ * @param sim Simulación entre dos eventos
+ * @param wait 1 para esperar a que el hilo termine la foto anterior, 0 para omitir esta si sigue ocupado
+ * @return 1 si se tomó la foto, 0 si se omitió
+ */
+int takeCheckpoint(CheckpointWriter *cw, const Simulacion *sim, int wait);
+
+
+/**
+ * @brief Espera a que se escriba la última foto, termina el hilo y libera el escritor.
+ *
+ * @param cw Escritor
+ * @return 0 si todas las escrituras salieron bien, si no el errno de la última que falló
+ */
+int closeCheckpointWriter(CheckpointWriter *cw);
+
+
+#endif
@@ -0,0 +1,588 @@
+/**
+ * @file simulacion.c
+ * @brief Definiciones de la simulación de eventos discretos.
+ *
+ * @details
+ * El puente se modela como una máquina de estados que reproduce el ciclo de recorrerEstacionamiento():
+ * admitir "window" vehículos (cada uno tarda medio PARKING_SPEED en salir de la cola y otro medio en entrar),
+ * vaciar el puente de a un espacio por PARKING_SPEED y pedir a la política la dirección y la ventana
+ * siguientes. En modo tubería reproduce crossPipelined(): un paso por PARKING_SPEED en el que entra un
+ * vehículo y sale otro. Las llegadas de cada puerta se agendan con las mismas distribuciones que arrivalScheduler().
+ *
+ * @date 16 de octubre de 2026 (creación)
+ * @version 1.0
+ * @authors
+ * Julio López
+ */
+
+#include <limits.h>
+#include <string.h>
+#include "simulacion.h"
+
+/**************************************
+ *      *COLA DE PRIORIDAD DE EVENTOS
+ *************************************/
+
+// Retorna distinto de 0 si el evento a debe atenderse antes que b.
+static int eventBefore(const SimEvent *a, const SimEvent *b) {
+    if (a->time != b->time) {
+        return a->time < b->time;
+    }
+    return a->seq < b->seq;
+}
+
+static int pushEvent(EventQueue *q, SimEvent ev) {
+    if (q->count == q->capacity) {
+        int newCapacity = (q->capacity > 0) ? 2 * q->capacity : 16;
+        SimEvent *heap = realloc(q->heap, newCapacity * sizeof(SimEvent));
+        if (heap == NULL) {
+            return -1;
+        }
+        q->heap = heap;
+        q->capacity = newCapacity;
+    }
+    ev.seq = q->nextSeq++;
+
+    // Subir el evento hasta su posición.
+    int i = q->count++;
+    while (i > 0) {
+        int parent = (i - 1) / 2;
+        if (!eventBefore(&ev, &q->heap[parent])) {
+            break;
+        }
+        q->heap[i] = q->heap[parent];
+        i = parent;
+    }
+    q->heap[i] = ev;
+    return 0;
+}
+
+static SimEvent popEvent(EventQueue *q) {
+    SimEvent top = q->heap[0];
+    SimEvent last = q->heap[--q->count];
+
+    // Bajar el último evento desde la raíz.
+    int i = 0;
+    while (1) {
+        int child = 2 * i + 1;
+        if (child >= q->count) {
+            break;
+        }
+        if (child + 1 < q->count && eventBefore(&q->heap[child + 1], &q->heap[child])) {
+            child++;
+        }
+        if (!eventBefore(&q->heap[child], &last)) {
+            break;
+        }
+        q->heap[i] = q->heap[child];
+        i = child;
+    }
+    if (q->count > 0) {
+        q->heap[i] = last;
+    }
+    return top;
+}
+
+/**************************************
+ *      *RELOJ VIRTUAL
+ *************************************/
+
+void scheduleEvent(Simulacion *sim, long long delay, SimEventType type, int side) {
+    SimEvent ev;
+    ev.time = sim->now + delay;
+    ev.seq = 0;
+    ev.type = type;
+    ev.side = side;
+    ev.origin = 0;
+    if (pushEvent(&sim->events, ev) != 0) {
+        fprintf(stderr, "simulacion: sin memoria para agendar eventos\n");
+        sim->running = 0;
+    }
+}
+
+double simTime(const Simulacion *sim) {
+    return sim->now / 1000000.0;
+}
+
+/**************************************
+ *      *MODELO DEL ESTACIONAMIENTO
+ *************************************/
+
+static void logEvent(const Simulacion *sim, char variable, int value) {
+    if (sim->trace != NULL) {
+        traceEvent(sim->trace, sim->now, variable, value, sim->dir, sim->window);
+    }
+    if (sim->p.verbose) {
+        printf("T:%12.4fs  Dir:%d  Window:%2d  Izq:%3d  Der:%3d  Cruzando:%2d  Done:%lld  %c\n",
+               simTime(sim), sim->dir, sim->window, countBuffer(sim->left), countBuffer(sim->right),
+               countBuffer(sim->parking), sim->contador_out, variable);
+    }
+}
+
+// Lado de la puerta que usa el flujo "source": los impares son de la izquierda.
+static int sourceSide(int source) {
+    return (source % 2 == 1) ? 1 : 2;
+}
+
+// Agenda la próxima llegada de una puerta. Igual que en arrivalScheduler(), con varias puertas por lado cada
+// una espera "gates" veces más y "phase" acorta la primera espera.
+static void scheduleArrival(Simulacion *sim, int source, double phase) {
+    int side = sourceSide(source);
+    long long waitingTime = arrivalGap(&sim->rng[source], sim->p.arrival, sim->p.arrivalMin[side],
+                                       sim->p.arrivalSpread[side]);
+    scheduleEvent(sim, (long long)(waitingTime * sim->p.gates * phase), EV_ARRIVAL, source);
+}
+
+static void beginBatch(Simulacion *sim);
+
+// Pide a la política la dirección y la ventana siguientes, igual que al final del ciclo del puente.
+static void endBatch(Simulacion *sim) {
+    CircularBuffer *queues[3] = {NULL, sim->left, sim->right};
+    CircularBuffer *lanes[3] = {NULL, sim->leftPriority, sim->rightPriority};
+    PolicyInput in;
+    int dir;
+
+    memset(&in, 0, sizeof(in));
+    in.dir = sim->dir;
+    in.now = sim->now;
+    in.oldest[0] = -1;
+    for (int side = 1; side <= 2; side++) {
+        int first = peekBuffer(queues[side]);
+        in.count[side] = countBuffer(queues[side]);
+        in.oldest[side] = (first > 0) ? vehicleTimes(&sim->vehicles[side], first)->arrival : -1;
+        in.arrivals[side] = sim->vehicles[side].committed;
+        in.priority[side] = countBuffer(lanes[side]);
+    }
+    decideNext(&sim->sched, &in, &dir, &sim->window);
+    if (dir != sim->dir) {
+        sim->flips++;
+    }
+    sim->dir = dir;
+    beginBatch(sim);
+}
+
+static void beginDrain(Simulacion *sim) {
+    if (!isBufferEmpty(sim->parking)) {
+        scheduleEvent(sim, sim->p.parkingSpeed, EV_CROSSING, 0);
+    } else {
+        endBatch(sim);
+    }
+}
+
+// Hay alguien esperando en la cola o en el carril de emergencias del lado.
+static int sideWaiting(Simulacion *sim, int side) {
+    return !isBufferEmpty((side == 1) ? sim->left : sim->right) ||
+           !isBufferEmpty((side == 1) ? sim->leftPriority : sim->rightPriority);
+}
+
+// Como preempted() de los hilos: una emergencia del lado contrario corta el lote antes de admitir a otro, salvo
+// que todavía haya emergencias del lado que tiene el paso o que el lote no haya admitido a nadie.
+static int preempted(Simulacion *sim) {
+    CircularBuffer *own = (sim->dir == 1) ? sim->leftPriority : sim->rightPriority;
+    CircularBuffer *other = (sim->dir == 1) ? sim->rightPriority : sim->leftPriority;
+    if (sim->batchIndex > 0 && isBufferEmpty(own) && !isBufferEmpty(other)) {
+        sim->preemptions++;
+        logEvent(sim, '!', 0);
+        return 1;
+    }
+    return 0;
+}
+
+// Igual que waitVehicle(): solo se admite un vehículo real. Si la cola está vacía se espera a lo sumo
+// admitTimeout a que llegue uno y, si no llega, se cierra el lote.
+static void nextAdmission(Simulacion *sim) {
+    if (sim->batchIndex < sim->window && (sim->dir == 1 || sim->dir == 2) && !preempted(sim)) {
+        if (sideWaiting(sim, sim->dir)) {
+            scheduleEvent(sim, sim->p.parkingSpeed / 2, EV_QUEUE_EXIT, sim->dir);
+        } else if (sim->p.admitTimeout > 0) {
+            sim->waitingSide = sim->dir;
+            scheduleEvent(sim, sim->p.admitTimeout, EV_ADMIT_TIMEOUT, ++sim->waitToken);
+        } else {
+            beginDrain(sim);
+        }
+    } else {
+        beginDrain(sim);
+    }
+}
+
+// Un paso del modo tubería (crossPipelined()): entra el siguiente vehículo si la entrada sigue abierta y hay
+// alguien esperando, o si llega uno antes de admitTimeout (como en nextAdmission()); si no, la entrada se
+// cierra y el puente avanza vacío hasta que sale el último.
+static void pipelineStep(Simulacion *sim) {
+    if (sim->admitting && sim->batchIndex < sim->window && !preempted(sim)) {
+        if (sideWaiting(sim, sim->dir)) {
+            scheduleEvent(sim, sim->p.parkingSpeed / 2, EV_QUEUE_EXIT, sim->dir);
+            return;
+        }
+        if (sim->p.admitTimeout > 0) {
+            sim->waitingSide = sim->dir;
+            scheduleEvent(sim, sim->p.admitTimeout, EV_ADMIT_TIMEOUT, ++sim->waitToken);
+            return;
+        }
+    }
+    // Como en crossPipelined(), el paso en que se cierra la entrada avanza el puente aunque esté vacío; si no,
+    // con las dos colas vacías endBatch() y beginBatch() se llamarían sin fin sin que avance el reloj.
+    if (sim->admitting) {
+        sim->admitting = 0;
+        scheduleEvent(sim, sim->p.parkingSpeed, EV_TICK, 0);
+        return;
+    }
+    if (!isBufferEmpty(sim->parking)) {
+        scheduleEvent(sim, sim->p.parkingSpeed, EV_TICK, 0);
+    } else {
+        endBatch(sim);
+    }
+}
+
+// Registra el vehículo que salió del puente, si salió alguno.
+static void vehicleLeft(Simulacion *sim, int value) {
+    if (value > 0) {
+        sim->contador_out++;
+        sim->exited[vehicleSide(value)]++;
+        recordCrossing(sim->vehicles, sim->latency, sim->priorityLatency, value, sim->now);
+        if (sim->onExit != NULL) {
+            int side = vehicleSide(value);
+            sim->onExit(sim->exitCtx, sim->now, side, vehicleTimes(&sim->vehicles[side], value)->origin);
+        }
+    }
+}
+
+// Como el ciclo del puente: no empieza otro lote si ya cruzaron más de maxVehicles o pasó maxDuration.
+static int limitReached(const Simulacion *sim) {
+    return sim->contador_out > sim->p.maxVehicles || (sim->p.maxDuration > 0 && sim->now >= sim->p.maxDuration);
+}
+
+static void beginBatch(Simulacion *sim) {
+    if (limitReached(sim)) {
+        sim->running = 0;
+        return;
+    }
+    sim->batchIndex = 0;
+    if (sim->p.pipelined) {
+        sim->admitting = (sim->dir == 1 || sim->dir == 2);
+        pipelineStep(sim);
+    } else {
+        nextAdmission(sim);
+    }
+}
+
+// Como takeVehicle() de los hilos: el carril de emergencias se atiende primero, salvo que ya salieron
+// PRIORITY_BURST seguidas y espera un vehículo común.
+static int takeVehicle(Simulacion *sim, int side) {
+    CircularBuffer *lane = (side == 1) ? sim->leftPriority : sim->rightPriority;
+    CircularBuffer *queue = (side == 1) ? sim->left : sim->right;
+    if (!isBufferEmpty(lane) && (sim->priorityStreak[side] < PRIORITY_BURST || isBufferEmpty(queue))) {
+        sim->priorityStreak[side]++;
+        return removeFromBuffer(lane);
+    }
+    sim->priorityStreak[side] = 0;
+    return removeFromBuffer(queue);
+}
+
+// Un vehículo llega a la cola del lado "side", o a su carril si es una emergencia; si está lleno se va.
+static void vehicleArrives(Simulacion *sim, int side, long long origin, int priority) {
+    CircularBuffer *queue = priority ? ((side == 1) ? sim->leftPriority : sim->rightPriority)
+                                     : ((side == 1) ? sim->left : sim->right);
+    int value = prepareVehicle(&sim->vehicles[side], sim->now);
+    sim->arrivals[side]++;
+    histRecord(&sim->queueDepth[side], countBuffer(queue));
+    if (addToBuffer(queue, value)) {
+        vehicleTimes(&sim->vehicles[side], value)->origin = origin;
+        vehicleTimes(&sim->vehicles[side], value)->priority = priority;
+        commitVehicle(&sim->vehicles[side]);
+        logEvent(sim, (side == 1) ? 'l' : 'r', value);
+        if (sim->waitingSide == side) {
+            // El puente esperaba en esta cola: el vehículo sale de inmediato.
+            sim->waitingSide = 0;
+            scheduleEvent(sim, sim->p.parkingSpeed / 2, EV_QUEUE_EXIT, side);
+        }
+    } else {
+        sim->rejected[side]++;
+        logEvent(sim, (side == 1) ? 'L' : 'R', value);
+    }
+}
+
+static void handleEvent(Simulacion *sim, const SimEvent *ev) {
+    int value, priority;
+
+    switch (ev->type) {
+    case EV_ARRIVAL:
+        // Como fireArrival(): la clase sale del flujo de la puerta, antes que la espera hasta la próxima.
+        priority = sim->p.priorityShare > 0 && randomUnit(&sim->rng[ev->side]) < sim->p.priorityShare;
+        vehicleArrives(sim, sourceSide(ev->side), sim->now, priority);
+        scheduleArrival(sim, ev->side, 1.0);
+        break;
+
+    case EV_TRANSFER:
+        sim->transfers[ev->side]++;
+        vehicleArrives(sim, ev->side, ev->origin, 0);
+        break;
+
+    case EV_BRIDGE_START:
+        beginBatch(sim);
+        break;
+
+    case EV_QUEUE_EXIT:
+        sim->moving = takeVehicle(sim, sim->dir);
+        recordDequeue(sim->vehicles, sim->latency, sim->priorityLatency, sim->moving, sim->now);
+        logEvent(sim, (sim->dir == 1) ? 'a' : 'b', sim->moving);
+        scheduleEvent(sim, sim->p.parkingSpeed / 2, EV_BRIDGE_ENTRY, sim->dir);
+        break;
+
+    case EV_BRIDGE_ENTRY:
+        if (sim->p.pipelined) {
+            value = shiftBuffer(sim->parking, sim->moving);     // En el mismo paso puede salir otro.
+            vehicleLeft(sim, value);
+            if (value > 0) {
+                logEvent(sim, 'O', value);
+            }
+        } else {
+            addToBuffer(sim->parking, sim->moving);
+            rotateBuffer(sim->parking);
+        }
+        sim->admitted[sim->dir]++;
+        logEvent(sim, (sim->dir == 1) ? 'A' : 'B', sim->moving);
+        sim->batchIndex++;
+        if (sim->p.pipelined) {
+            pipelineStep(sim);
+        } else {
+            nextAdmission(sim);
+        }
+        break;
+
+    case EV_CROSSING:
+        value = removeFromBuffer(sim->parking);
+        vehicleLeft(sim, value);
+        logEvent(sim, 'O', value);
+        if (!isBufferEmpty(sim->parking)) {
+            scheduleEvent(sim, sim->p.parkingSpeed, EV_CROSSING, 0);
+        } else {
+            endBatch(sim);
+        }
+        break;
+
+    case EV_TICK:
+        value = shiftBuffer(sim->parking, 0);
+        vehicleLeft(sim, value);
+        logEvent(sim, 'O', value);
+        pipelineStep(sim);
+        break;
+
+    case EV_ADMIT_TIMEOUT:
+        if (sim->waitingSide != 0 && ev->side == sim->waitToken) {
+            sim->waitingSide = 0;
+            if (sim->p.pipelined) {
+                sim->admitting = 0;     // El paso que cierra la entrada, como en pipelineStep().
+                scheduleEvent(sim, sim->p.parkingSpeed, EV_TICK, 0);
+            } else {
+                beginDrain(sim);
+            }
+        }
+        break;
+    }
+}
+
+/**************************************
+ *      *CICLO DE VIDA
+ *************************************/
+
+int initSimulation(Simulacion *sim, const SimParams *params) {
+    memset(sim, 0, sizeof(Simulacion));
+    sim->p = *params;
+    int streams = 1 + 2 * params->gates;
+    sim->rng = malloc(streams * sizeof(Rng));
+    if (sim->rng == NULL) {
+        return -1;
+    }
+    for (int stream = 0; stream < streams; stream++) {
+        seedRng(&sim->rng[stream], params->seed, stream);
+    }
+    sim->window = params->windowSize;
+    sim->dir = 0;
+    sim->running = 1;
+    sim->nextPeriodic = LLONG_MAX;
+    initPolicy(&sim->sched, params->policy, &params->weights, params->parkingSpeed);
+
+    sim->left = createBuffer(params->bufferSize);
+    sim->right = createBuffer(params->bufferSize);
+    sim->leftPriority = createBuffer(params->bufferSize);
+    sim->rightPriority = createBuffer(params->bufferSize);
+    sim->parking = createBuffer(params->parkingSize);
+    if (sim->left == NULL || sim->right == NULL || sim->leftPriority == NULL || sim->rightPriority == NULL ||
+        sim->parking == NULL) {
+        freeSimulation(sim);
+        return -1;
+    }
+    for (int side = 1; side <= 2; side++) {
+        if (vehicleTableInit(&sim->vehicles[side], side, 2 * params->bufferSize + params->parkingSize + 2) != 0) {
+            freeSimulation(sim);
+            return -1;
+        }
+        latencyInit(&sim->latency[side]);
+        latencyInit(&sim->priorityLatency[side]);
+        histInit(&sim->queueDepth[side]);
+    }
+
+    // Llenado inicial de las colas
+    int initial_left_amount = 4 + randomBelow(&sim->rng[0], 3);
+    sim->initialFill[1] = initial_left_amount;
+    for (int i = 0; i < initial_left_amount; i++) {
+        addToBuffer(sim->left, prepareVehicle(&sim->vehicles[1], 0));
+        commitVehicle(&sim->vehicles[1]);
+    }
+    int initial_right_amount = 4 + randomBelow(&sim->rng[0], 3);
+    sim->initialFill[2] = initial_right_amount;
+    for (int i = 0; i < initial_right_amount; i++) {
+        addToBuffer(sim->right, prepareVehicle(&sim->vehicles[2], 0));
+        commitVehicle(&sim->vehicles[2]);
+    }
+
+    scheduleEvent(sim, 3 * params->parkingSpeed, EV_BRIDGE_START, 0);
+    for (int source = 1; source < streams; source++) {
+        scheduleArrival(sim, source, (params->gates > 1) ? randomUnit(&sim->rng[source]) : 1.0);
+    }
+    return sim->running ? 0 : -1;
+}
+
+// Llama, en orden, a los avisos que vencen hasta "until" (el instante del próximo evento).
+static void runPeriodic(Simulacion *sim, long long until) {
+    while (sim->nextPeriodic <= until) {
+        long long at = sim->nextPeriodic;
+        sim->now = at;              // Entre dos eventos no pasa nada: el reloj puede adelantarse hasta aquí.
+        sim->nextPeriodic = LLONG_MAX;
+        for (int i = 0; i < sim->periodicCount; i++) {
+            SimPeriodic *hook = &sim->periodic[i];
+            if (hook->next == at) {
+                hook->fn(hook->ctx, sim);
+                hook->next += hook->every;
+            }
+            if (hook->next < sim->nextPeriodic) {
+                sim->nextPeriodic = hook->next;
+            }
+        }
+    }
+}
+
+int addPeriodic(Simulacion *sim, long long every, void (*fn)(void *ctx, const struct Simulacion *sim), void *ctx) {
+    if (sim->periodicCount >= SIM_PERIODIC_MAX || every <= 0) {
+        return -1;
+    }
+    SimPeriodic *hook = &sim->periodic[sim->periodicCount++];
+    hook->fn = fn;
+    hook->ctx = ctx;
+    hook->every = every;
+    hook->next = sim->now + every;
+    if (hook->next < sim->nextPeriodic) {
+        sim->nextPeriodic = hook->next;
+    }
+    return 0;
+}
+
+int stepSimulation(Simulacion *sim, long long maxEvents) {
+    for (long long i = 0; i < maxEvents && sim->running && sim->events.count > 0 &&
+                          !ATOMIC_LOAD_RLX(&sim->cancelled); i++) {
+        if (sim->events.heap[0].time >= sim->nextPeriodic) {
+            runPeriodic(sim, sim->events.heap[0].time);
+        }
+        SimEvent ev = popEvent(&sim->events);
+        sim->now = ev.time;         // El reloj salta directo al siguiente evento.
+        sim->eventsProcessed++;
+        handleEvent(sim, &ev);
+    }
+    return sim->running && sim->events.count > 0 && !ATOMIC_LOAD_RLX(&sim->cancelled);
+}
+
+int advanceSimulation(Simulacion *sim, long long until) {
+    while (sim->running && sim->events.count > 0 && sim->events.heap[0].time < until) {
+        SimEvent ev = popEvent(&sim->events);
+        sim->now = ev.time;
+        sim->eventsProcessed++;
+        handleEvent(sim, &ev);
+    }
+    return sim->running && sim->events.count > 0;
+}
+
+void resumeSimulation(Simulacion *sim) {
+    if (!sim->running && !limitReached(sim)) {
+        sim->running = 1;
+        beginBatch(sim);
+    }
+}
+
+void reseedSimulation(Simulacion *sim, unsigned long long seed) {
+    sim->p.seed = seed;
+    for (int stream = 0; stream < 1 + 2 * sim->p.gates; stream++) {
+        seedRng(&sim->rng[stream], seed, stream);
+    }
+}
+
+long long nextEventTime(const Simulacion *sim) {
+    return (sim->events.count > 0) ? sim->events.heap[0].time : LLONG_MAX;
+}
+
+void injectVehicle(Simulacion *sim, long long time, int side, long long origin) {
+    SimEvent ev;
+    ev.time = time;
+    ev.seq = 0;
+    ev.type = EV_TRANSFER;
+    ev.side = side;
+    ev.origin = origin;
+    if (pushEvent(&sim->events, ev) != 0) {
+        fprintf(stderr, "simulacion: sin memoria para agendar eventos\n");
+        sim->running = 0;
+    }
+}
+
+void runSimulation(Simulacion *sim) {
+    while (stepSimulation(sim, 1)) {
+        if (statsReportRequested) {
+            statsReportRequested = 0;
+            printLatencyReport(stderr, sim->latency);
+        }
+    }
+}
+
+void freeSimulation(Simulacion *sim) {
+    destroyBuffer(sim->left);
+    destroyBuffer(sim->right);
+    destroyBuffer(sim->leftPriority);
+    destroyBuffer(sim->rightPriority);
+    destroyBuffer(sim->parking);
+    free(sim->events.heap);
+    vehicleTableFree(&sim->vehicles[1]);
+    vehicleTableFree(&sim->vehicles[2]);
+    free(sim->rng);
+    sim->rng = NULL;
+    sim->left = sim->right = sim->leftPriority = sim->rightPriority = sim->parking = NULL;
+    sim->events.heap = NULL;
+    sim->events.count = sim->events.capacity = 0;
+}
+
+void printSimulationSummary(const Simulacion *sim, FILE *out, double wallSeconds) {
+    double simulated = simTime(sim);
+    fprintf(out, "Simulación de eventos discretos\n");
+    fprintf(out, "  Tiempo simulado:      %.3f s\n", simulated);
+    fprintf(out, "  Tiempo real:          %.3f s", wallSeconds);
+    if (wallSeconds > 0) {
+        fprintf(out, " (x%.0f)", simulated / wallSeconds);
+    }
+    fprintf(out, "\n");
+    fprintf(out, "  Eventos atendidos:    %lld\n", sim->eventsProcessed);
+    fprintf(out, "  Llegadas:             %s, semilla %llu\n", arrivalName(sim->p.arrival), sim->p.seed);
+    fprintf(out, "  Vehículos cruzados:   %lld (izquierda %lld, derecha %lld)\n",
+            sim->contador_out, sim->exited[1], sim->exited[2]);
+    fprintf(out, "  Llenado inicial:      %lld (izquierda %lld, derecha %lld)\n",
+            sim->initialFill[1] + sim->initialFill[2], sim->initialFill[1], sim->initialFill[2]);
+    fprintf(out, "  Llegadas izquierda:   %lld (rechazadas %lld)\n", sim->arrivals[1], sim->rejected[1]);
+    fprintf(out, "  Llegadas derecha:     %lld (rechazadas %lld)\n", sim->arrivals[2], sim->rejected[2]);
+    fprintf(out, "  Cambios de dirección: %lld\n", sim->flips);
+    if (sim->p.priorityShare > 0) {
+        fprintf(out, "  Emergencias:          %.1f%% de las llegadas, %lld lotes cortados\n",
+                100.0 * sim->p.priorityShare, sim->preemptions);
+    }
+    if (simulated > 0) {
+        fprintf(out, "  Throughput:           %.4f vehículos/s\n", sim->contador_out / simulated);
+    }
+    printLatencyReport(out, sim->latency);
+    printPriorityReport(out, sim->priorityLatency);
+}
@@ -0,0 +1,255 @@
+/**
+ * @file simulacion.h
+ * @brief Simulación de eventos discretos del estacionamiento.
+ *
+ * @details
+ * Modela el mismo sistema que los hilos de main.c (llegadas a las colas, salida de la cola, entrada al puente
+ * y cruce) como eventos con marca de tiempo ordenados en una cola de prioridad. El reloj es virtual: en vez de
+ * dormir con my_sleep() se agenda el siguiente evento y el reloj salta directamente a él, por lo que una corrida
+ * de millones de vehículos termina en segundos. La dirección y la ventana las decide la misma política que usa
+ * el hilo del puente (decideNext()).
+ *
+ * @date 16 de octubre de 2026 (creación)
+ * @version 1.0
+ * @authors
+ * Julio López
+ */
+
+#ifndef SIMULACION_H
+#define SIMULACION_H
+
+#include <stdio.h>
+#include "funciones.h"
+#include "estadisticas.h"
+#include "traza.h"
+
+/**
+ * @brief Tipos de evento de la simulación.
+ */
+typedef enum {
+    EV_ARRIVAL,         /**< Llega un vehículo a una cola ('l' / 'r') */
+    EV_BRIDGE_START,    /**< El puente comienza a operar (tras 3*PARKING_SPEED) */
+    EV_QUEUE_EXIT,      /**< Un vehículo sale de la cola ('a' / 'b') */
+    EV_BRIDGE_ENTRY,    /**< El vehículo entra al puente ('A' / 'B') */
+    EV_CROSSING,        /**< El puente avanza un espacio, puede salir un vehículo ('O') */
+    EV_ADMIT_TIMEOUT,   /**< Venció la espera por un vehículo en una cola vacía: se cierra el lote */
+    EV_TICK,            /**< En modo tubería, el puente avanza un espacio sin que entre nadie ('O') */
+    EV_TRANSFER         /**< Llega a una cola un vehículo que viene de otro tramo de la red ('l' / 'r') */
+} SimEventType;
+
+/**
+ * @brief Un evento agendado. A igual tiempo se respeta el orden en que se agendaron.
+ */
+typedef struct {
+    long long time;     /**< Instante virtual en microsegundos */
+    long long seq;      /**< Orden de agendamiento, desempata eventos simultáneos */
+    SimEventType type;  /**< Tipo de evento */
+    int side;           /**< 1 izquierda, 2 derecha; flujo de la puerta (EV_ARRIVAL); número de espera (EV_ADMIT_TIMEOUT) */
+    long long origin;   /**< En EV_TRANSFER, instante en que el vehículo entró a la red */
+} SimEvent;
+
+/**
+ * @brief Cola de prioridad (min-heap binario) de eventos.
+ */
+typedef struct {
+    SimEvent* heap;     /**< Arreglo del heap */
+    int count;          /**< Eventos pendientes */
+    int capacity;       /**< Capacidad reservada */
+    long long nextSeq;  /**< Próximo número de secuencia */
+} EventQueue;
+
+#define SIM_PERIODIC_MAX    2       // Avisos periódicos por simulación
+
+struct Simulacion;
+
+/**
+ * @brief Un aviso que se llama cada "every" de tiempo virtual, entre dos eventos (ver addPeriodic()).
+ */
+typedef struct {
+    void (*fn)(void *ctx, const struct Simulacion *sim);    /**< Aviso */
+    void *ctx;                                              /**< Se pasa tal cual a fn */
+    long long every;                                        /**< Intervalo (us virtuales) */
+    long long next;                                         /**< Próximo instante (us virtuales) */
+} SimPeriodic;
+
+/**
+ * @brief Estado completo de una instancia de la simulación. Lo que se agregue aquí también hay que guardarlo
+ * en los puntos de control (serializeSimulation() y loadCheckpoint() en respaldo.c).
+ */
+typedef struct Simulacion {
+    SimParams p;                    /**< Parámetros de la corrida */
+    long long now;                  /**< Reloj virtual en microsegundos */
+    EventQueue events;              /**< Eventos pendientes */
+    CircularBuffer *left;           /**< Cola de espera izquierda */
+    CircularBuffer *right;          /**< Cola de espera derecha */
+    CircularBuffer *leftPriority;   /**< Carril de emergencias izquierdo, se atiende antes que left */
+    CircularBuffer *rightPriority;  /**< Carril de emergencias derecho, se atiende antes que right */
+    CircularBuffer *parking;        /**< Espacios del puente */
+    int dir;                        /**< Dirección actual (0 al inicio, 1 izquierda, 2 derecha) */
+    int window;                     /**< Tamaño de la ventana actual */
+    SchedPolicy sched;              /**< Decide dirección y ventana al terminar cada lote */
+    int batchIndex;                 /**< Vehículos de la ventana ya procesados */
+    int moving;                     /**< Vehículo entre la salida de la cola y la entrada al puente */
+    int admitting;                  /**< En modo tubería, 1 mientras la entrada del lote está abierta */
+    int waitingSide;                /**< Cola vacía en la que el puente espera un vehículo (0: no espera) */
+    int waitToken;                  /**< Número de la espera actual, descarta plazos ya atendidos */
+    int running;                    /**< 0 cuando el puente terminó */
+    int priorityStreak[3];          /**< Emergencias seguidas que salieron de cada lado (ver PRIORITY_BURST) */
+    Rng *rng;                       /**< Generadores: 0 llenado inicial, 2 * g + lado la puerta g de cada lado */
+    long long contador_out;         /**< Vehículos que cruzaron */
+    long long arrivals[3];          /**< Llegadas por lado (índices 1 y 2) */
+    long long rejected[3];          /**< Llegadas rechazadas por cola llena */
+    long long admitted[3];          /**< Vehículos que entraron al puente por lado */
+    long long exited[3];            /**< Vehículos que salieron del puente por lado */
+    long long initialFill[3];       /**< Vehículos en cada cola al empezar; no cuentan en arrivals */
+    long long flips;                /**< Cambios de dirección */
+    long long preemptions;          /**< Lotes cortados por una emergencia del lado contrario */
+    long long eventsProcessed;      /**< Eventos atendidos */
+    VehicleTable vehicles[3];       /**< Identidad de los vehículos por lado */
+    LatencyStats latency[3];        /**< Latencias por lado */
+    LatencyStats priorityLatency[3];    /**< Latencias de los vehículos de emergencia por lado */
+    Histogram queueDepth[3];        /**< Vehículos que encuentra en la cola cada llegada, por lado */
+    TraceFile *trace;               /**< Si no es NULL, cada evento se guarda también en la traza */
+    long long transfers[3];         /**< Llegadas desde otros tramos por lado */
+    /** Si no es NULL, se llama por cada vehículo que termina de cruzar, con el lado del que vino */
+    void (*onExit)(void *ctx, long long time, int side, long long origin);
+    void *exitCtx;                  /**< Se pasa tal cual a onExit */
+    SimPeriodic periodic[SIM_PERIODIC_MAX];     /**< Avisos periódicos: puntos de control, estadísticas */
+    int periodicCount;              /**< Avisos agregados */
+    long long nextPeriodic;         /**< El más próximo de los avisos, LLONG_MAX si no hay */
+    ATOMIC_INT cancelled;           /**< Otro hilo lo pone en 1 para detener la corrida entre dos eventos */
+} Simulacion;
+
+
+/**
+ * @brief Inicializa una simulación con los parámetros dados y agenda los primeros eventos.
+ *
+ * @param sim Simulación a inicializar
+ * @param params Parámetros de la corrida
+ * @return 0 si todo salió bien, -1 si no hubo memoria
+ */
+int initSimulation(Simulacion *sim, const SimParams *params);
+
+
+/**
+ * @brief Atiende eventos hasta que el puente termina o se cancela la corrida (cancelled).
+ *
+ * @param sim Simulación inicializada
+ */
+void runSimulation(Simulacion *sim);
+
+
+/**
+ * @brief Atiende a lo sumo maxEvents eventos. Permite correr la simulación por tramos y retomarla después,
+ * incluso desde otro hilo.
+ *
+ * @param sim Simulación inicializada
+ * @param maxEvents Eventos a atender en este tramo
+ * @return 1 si la simulación sigue, 0 si el puente terminó o se canceló
+ */
+int stepSimulation(Simulacion *sim, long long maxEvents);
+
+
+/**
+ * @brief Atiende los eventos anteriores a "until". Los eventos en "until" o después quedan pendientes.
+ *
+ * @param sim Simulación inicializada
+ * @param until Instante virtual en microsegundos
+ * @return 1 si la simulación sigue, 0 si el puente terminó
+ */
+int advanceSimulation(Simulacion *sim, long long until);
+
+
+/**
+ * @brief Deja la simulación lista para seguir después de cargar un punto de control, con los límites
+ * (maxVehicles, maxDuration) ya cambiados si se quiere correr más: si el puente se había detenido en un
+ * límite, vuelve a empezar el lote que no empezó.
+ *
+ * @param sim Simulación cargada
+ */
+void resumeSimulation(Simulacion *sim);
+
+
+/**
+ * @brief Cambia la semilla de los flujos de llegadas desde el instante actual. Las llegadas ya agendadas no
+ * cambian; sirve para abrir corridas distintas desde un mismo punto de control.
+ *
+ * @param sim Simulación
+ * @param seed Semilla nueva
+ */
+void reseedSimulation(Simulacion *sim, unsigned long long seed);
+
+
+/**
+ * @brief Agrega un aviso que stepSimulation() llama cada "every" us virtuales, el primero en now + every. Se
+ * llama en el instante exacto, antes de los eventos de ese instante: el estado es el que dejó el último evento
+ * anterior, el reloj de la simulación marca ese instante y el resultado no depende del tiempo real.
+ *
+ * @param sim Simulación
+ * @param every Intervalo en microsegundos virtuales, mayor que 0
+ * @param fn Aviso
+ * @param ctx Contexto de fn
+ * @return 0 si se agregó, -1 si ya hay SIM_PERIODIC_MAX
+ */
+int addPeriodic(Simulacion *sim, long long every, void (*fn)(void *ctx, const struct Simulacion *sim), void *ctx);
+
+
+/**
+ * @brief Instante del próximo evento pendiente.
+ *
+ * @param sim Simulación
+ * @return long long Instante en microsegundos, o LLONG_MAX si no queda ninguno
+ */
+long long nextEventTime(const Simulacion *sim);
+
+
+/**
+ * @brief Agenda la llegada de un vehículo que viene de otro tramo.
+ *
+ * @param sim Simulación de destino
+ * @param time Instante de llegada, no anterior al reloj de la simulación
+ * @param side Cola a la que llega (1 izquierda, 2 derecha)
+ * @param origin Instante en que el vehículo entró a la red
+ */
+void injectVehicle(Simulacion *sim, long long time, int side, long long origin);
+
+
+/**
+ * @brief Libera la memoria de la simulación.
+ *
+ * @param sim Simulación a liberar
+ */
+void freeSimulation(Simulacion *sim);
+
+
+/**
+ * @brief Agenda un evento dentro de "delay" microsegundos virtuales. Reemplaza a my_sleep().
+ *
+ * @param sim Simulación
+ * @param delay Retardo en microsegundos desde el instante actual
+ * @param type Tipo de evento
+ * @param side Lado asociado al evento
+ */
+void scheduleEvent(Simulacion *sim, long long delay, SimEventType type, int side);
+
+
+/**
+ * @brief Tiempo virtual transcurrido en segundos. Reemplaza a get_time().
+ *
+ * @param sim Simulación
+ * @return double
+ */
+double simTime(const Simulacion *sim);
+
+
+/**
+ * @brief Imprime un resumen de la corrida.
+ *
+ * @param sim Simulación terminada
+ * @param out Archivo de salida
+ * @param wallSeconds Tiempo real que tomó la corrida
+ */
+void printSimulationSummary(const Simulacion *sim, FILE *out, double wallSeconds);
+
+
+#endif
@@ -0,0 +1,92 @@
+/**
+ * @file temporizador.c
+ * @brief Definiciones de la rueda de temporizadores jerárquica.
+ *
+ * @date 16 de octubre de 2026 (creación)
+ * @version 1.0
+ * @authors
+ * Julio López
+ */
+
+#include <string.h>
+#include "temporizador.h"
+
+#define WHEEL_MASK      (WHEEL_SLOTS - 1)
+
+void initTimerWheel(TimerWheel *tw, long long now) {
+    memset(tw->slots, 0, sizeof(tw->slots));
+    tw->now = now;
+    tw->count = 0;
+}
+
+// Ubica el nodo según cuánto falta: el nivel más bajo cuyo alcance lo cubre, en la ranura de su tick.
+static void placeNode(TimerWheel *tw, TimerNode *node) {
+    long long delta = node->tick - tw->now;
+    int level = 0;
+    if (delta < 0) {
+        node->tick = tw->now;
+        delta = 0;
+    }
+    while (level < WHEEL_LEVELS - 1 && delta >= (1LL << (WHEEL_BITS * (level + 1)))) {
+        level++;
+    }
+    int slot = (int)((node->tick >> (WHEEL_BITS * level)) & WHEEL_MASK);
+    node->next = tw->slots[level][slot];
+    tw->slots[level][slot] = node;
+}
+
+void timerAdd(TimerWheel *tw, TimerNode *node) {
+    placeNode(tw, node);
+    tw->count++;
+}
+
+// Reparte la ranura del nivel "level" que empieza en el tick actual entre los niveles de abajo.
+static void cascade(TimerWheel *tw, int level) {
+    int slot = (int)((tw->now >> (WHEEL_BITS * level)) & WHEEL_MASK);
+    TimerNode *node = tw->slots[level][slot];
+    tw->slots[level][slot] = NULL;
+    while (node != NULL) {
+        TimerNode *next = node->next;
+        placeNode(tw, node);
+        node = next;
+    }
+}
+
+int advanceTimerWheel(TimerWheel *tw, long long tick, TimerFire fire, void *ctx) {
+    int fired = 0;
+    while (tw->now <= tick) {
+        // Al empezar una vuelta del nivel 0 baja la ranura que sigue de cada nivel que también dio la vuelta.
+        for (int level = 1; level < WHEEL_LEVELS; level++) {
+            if ((tw->now & ((1LL << (WHEEL_BITS * level)) - 1)) != 0) {
+                break;
+            }
+            cascade(tw, level);
+        }
+
+        // Quien dispara puede volver a agendar para este mismo tick: se repite hasta que la ranura quede vacía.
+        TimerNode **slot = &tw->slots[0][tw->now & WHEEL_MASK];
+        while (*slot != NULL) {
+            TimerNode *node = *slot;
+            *slot = NULL;
+            while (node != NULL) {
+                TimerNode *next = node->next;
+                tw->count--;
+                fired++;
+                fire(node, ctx);
+                node = next;
+            }
+        }
+        tw->now++;
+    }
+    return fired;
+}
+
+long long timerNextTick(const TimerWheel *tw) {
+    long long end = (tw->now | WHEEL_MASK) + 1;
+    for (long long t = tw->now; t < end; t++) {
+        if (tw->slots[0][t & WHEEL_MASK] != NULL) {
+            return t;
+        }
+    }
+    return end;
+}
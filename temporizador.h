@@ -0,0 +1,93 @@
+/**
+ * @file temporizador.h
+ * @brief Rueda de temporizadores jerárquica para agendar muchas llegadas desde un solo hilo.
+ *
+ * @details
+ * El tiempo avanza en ticks enteros. La rueda tiene WHEEL_LEVELS niveles de WHEEL_SLOTS ranuras: el nivel 0
+ * guarda los temporizadores de los próximos WHEEL_SLOTS ticks, uno por ranura, y cada nivel siguiente cubre
+ * un rango WHEEL_SLOTS veces mayor con ranuras igual de más anchas. Cuando el nivel 0 da la vuelta, la ranura
+ * que corresponde del nivel 1 se reparte ("cascada") entre las ranuras de abajo, y así sucesivamente.
+ * Agregar un temporizador y dispararlo cuestan O(1); cada temporizador baja a lo sumo WHEEL_LEVELS - 1 veces.
+ *
+ * Los nodos son parte de la estructura de quien los usa, la rueda no reserva memoria.
+ *
+ * @date 16 de octubre de 2026 (creación)
+ * @version 1.0
+ * @authors
+ * Julio López
+ */
+
+#ifndef TEMPORIZADOR_H
+#define TEMPORIZADOR_H
+
+#define WHEEL_BITS      8
+#define WHEEL_SLOTS     (1 << WHEEL_BITS)
+#define WHEEL_LEVELS    4       // Alcance de 2^32 ticks
+
+/**
+ * @brief Un temporizador agendado.
+ */
+typedef struct TimerNode {
+    struct TimerNode *next;     /**< Siguiente en la misma ranura */
+    long long tick;             /**< Tick en que vence */
+    void *owner;                /**< Dueño del nodo, lo recibe la función de disparo */
+} TimerNode;
+
+/**
+ * @brief La rueda. La usa un solo hilo.
+ */
+typedef struct {
+    TimerNode *slots[WHEEL_LEVELS][WHEEL_SLOTS];    /**< Listas de temporizadores por ranura */
+    long long now;                                  /**< Próximo tick a procesar */
+    int count;                                      /**< Temporizadores agendados */
+} TimerWheel;
+
+/**
+ * @brief Función que se llama al vencer un temporizador. Puede volver a agendar el mismo nodo.
+ */
+typedef void (*TimerFire)(TimerNode *node, void *ctx);
+
+
+/**
+ * @brief Deja la rueda vacía.
+ *
+ * @param tw Rueda a inicializar
+ * @param now Tick inicial
+ */
+void initTimerWheel(TimerWheel *tw, long long now);
+
+
+/**
+ * @brief Agenda un temporizador. Si el tick ya pasó, vence en el próximo avance.
+ *
+ * @param tw Rueda
+ * @param node Nodo, con tick y owner ya asignados
+ */
+void timerAdd(TimerWheel *tw, TimerNode *node);
+
+
+/**
+ * @brief Dispara, en orden de tick, todos los temporizadores que vencen hasta "tick" inclusive.
+ *
+ * @param tw Rueda
+ * @param tick Tick actual
+ * @param fire Función a llamar por cada temporizador vencido
+ * @param ctx Se pasa tal cual a fire
+ * @return int Cantidad de temporizadores disparados
+ */
+int advanceTimerWheel(TimerWheel *tw, long long tick, TimerFire fire, void *ctx);
+
+
+/**
+ * @brief Tick hasta el que se puede dormir sin atrasar ningún temporizador.
+ *
+ * Es el vencimiento más cercano del nivel 0, o el comienzo de su próxima vuelta si está vacío; así se
+ * recorren a lo sumo WHEEL_SLOTS ranuras.
+ *
+ * @param tw Rueda
+ * @return long long
+ */
+long long timerNextTick(const TimerWheel *tw);
+
+
+#endif
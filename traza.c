@@ -0,0 +1,121 @@
+/**
+ * @file traza.c
+ * @brief Definiciones de la traza binaria de eventos.
+ *
+ * @date 16 de octubre de 2026 (creación)
+ * @version 1.0
+ * @authors
+ * Julio López
+ */
+
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "traza.h"
+
+static int mapTrace(TraceFile *tf, int fd, size_t size, int prot) {
+    void *map = mmap(NULL, size, prot, MAP_SHARED, fd, 0);
+    close(fd);                  // El mapeo sigue válido sin el descriptor.
+    if (map == MAP_FAILED) {
+        return -1;
+    }
+    tf->header = (TraceHeader*)map;
+    tf->records = (TraceRecord*)((char*)map + sizeof(TraceHeader));
+    tf->mapSize = size;
+    return 0;
+}
+
+int openTraceWriter(TraceFile *tf, const char *path, long long capacity, const SimParams *params) {
+    long long n = 1;
+    while (n < capacity) {
+        n <<= 1;
+    }
+    size_t size = sizeof(TraceHeader) + (size_t)n * sizeof(TraceRecord);
+
+    int fd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        return -1;
+    }
+    if (ftruncate(fd, (off_t)size) != 0) {
+        close(fd);
+        return -1;
+    }
+    if (mapTrace(tf, fd, size, PROT_READ | PROT_WRITE) != 0) {
+        return -1;
+    }
+
+    // El archivo recién truncado está en ceros: solo hace falta la cabecera.
+    TraceHeader *h = tf->header;
+    memcpy(h->magic, TRACE_MAGIC, sizeof(h->magic));
+    h->version = TRACE_VERSION;
+    h->recordSize = sizeof(TraceRecord);
+    h->capacity = n;
+    h->bufferSize = params->bufferSize;
+    h->parkingSize = params->parkingSize;
+    h->parkingSpeed = params->parkingSpeed;
+    h->pipelined = params->pipelined;
+    ATOMIC_STORE(&h->next, 0);
+    tf->mask = n - 1;
+    return 0;
+}
+
+int openTraceReader(TraceFile *tf, const char *path) {
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        return -1;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(TraceHeader)) {
+        close(fd);
+        return -1;
+    }
+    if (mapTrace(tf, fd, (size_t)st.st_size, PROT_READ) != 0) {
+        return -1;
+    }
+
+    const TraceHeader *h = tf->header;
+    if (memcmp(h->magic, TRACE_MAGIC, sizeof(h->magic)) != 0 || h->version != TRACE_VERSION ||
+        h->recordSize != sizeof(TraceRecord) || h->capacity <= 0 || (h->capacity & (h->capacity - 1)) != 0 ||
+        sizeof(TraceHeader) + (size_t)h->capacity * sizeof(TraceRecord) > tf->mapSize) {
+        closeTrace(tf);
+        return -1;
+    }
+    tf->mask = h->capacity - 1;
+    return 0;
+}
+
+void traceEvent(TraceFile *tf, long long time, char code, int vehicle, int dir, int window) {
+    long long pos = ATOMIC_ADD(&tf->header->next, 1);
+    TraceRecord *r = &tf->records[pos & tf->mask];
+    r->code = 0;                // Incompleto mientras se escribe.
+    r->time = time;
+    r->vehicle = vehicle;
+    r->dir = (uint8_t)dir;
+    r->window = (uint16_t)window;
+    ATOMIC_FENCE_REL();
+    r->code = code;
+}
+
+long long traceFirst(const TraceFile *tf) {
+    long long end = traceEnd(tf);
+    return (end > tf->header->capacity) ? end - tf->header->capacity : 0;
+}
+
+long long traceEnd(const TraceFile *tf) {
+    return ATOMIC_LOAD_RLX(&tf->header->next);     // Se lee después de la corrida, o es solo una foto.
+}
+
+const TraceRecord* traceAt(const TraceFile *tf, long long pos) {
+    return &tf->records[pos & tf->mask];
+}
+
+void closeTrace(TraceFile *tf) {
+    if (tf->header != NULL) {
+        msync(tf->header, tf->mapSize, MS_ASYNC);
+        munmap(tf->header, tf->mapSize);
+    }
+    tf->header = NULL;
+    tf->records = NULL;
+}
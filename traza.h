@@ -0,0 +1,141 @@
+/**
+ * @file traza.h
+ * @brief Traza binaria de eventos en un archivo circular mapeado en memoria.
+ *
+ * @details
+ * Cada evento que pasa por printState() se guarda como un registro de 16 bytes (instante, vehículo, código,
+ * dirección y ventana) en un archivo mapeado con mmap(). Escribir un registro es reservar una posición con un
+ * incremento atómico y copiar cuatro campos: no hay formateo de texto, syscalls ni bloqueos, y el sistema
+ * operativo baja las páginas al disco por su cuenta. El archivo es circular: cuando se llena se sobrescriben
+ * los registros más viejos, así una corrida larga guarda siempre los últimos "capacity" eventos.
+ *
+ * El archivo empieza con una cabecera que identifica el formato y los parámetros de la corrida; el programa
+ * reproducir lo lee para reproducir la corrida en pantalla o calcular estadísticas.
+ *
+ * @date 16 de octubre de 2026 (creación)
+ * @version 1.0
+ * @authors
+ * Julio López
+ */
+
+#ifndef TRAZA_H
+#define TRAZA_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "funciones.h"
+
+#define TRACE_MAGIC         "PUENTETR"
+#define TRACE_VERSION       1
+#define TRACE_RECORDS       (1 << 20)   // Registros por defecto (16 MiB)
+
+/**
+ * @brief Un evento. El código se escribe al final: un registro con código 0 está incompleto.
+ */
+typedef struct {
+    int64_t time;       /**< Instante en microsegundos desde el inicio de la corrida */
+    int32_t vehicle;    /**< Identificador del vehículo (0 si no hay) */
+    char code;          /**< Código de printState(): a A b B O l r L R */
+    uint8_t dir;        /**< Dirección del puente en ese instante */
+    uint16_t window;    /**< Ventana en ese instante */
+} TraceRecord;
+
+/**
+ * @brief Cabecera del archivo, ocupa una línea de caché.
+ */
+typedef struct {
+    char magic[8];          /**< TRACE_MAGIC */
+    uint32_t version;       /**< TRACE_VERSION */
+    uint32_t recordSize;    /**< sizeof(TraceRecord) */
+    int64_t capacity;       /**< Cantidad de registros, potencia de 2 */
+    int32_t bufferSize;     /**< Capacidad de cada cola */
+    int32_t parkingSize;    /**< Capacidad del puente */
+    int32_t parkingSpeed;   /**< Tiempo en microsegundos para avanzar un espacio */
+    int32_t pipelined;      /**< Modo del puente */
+    ATOMIC_LLONG next;      /**< Registros escritos desde el inicio */
+    char pad[CACHE_LINE_SIZE - 48];
+} TraceHeader;
+
+/**
+ * @brief Archivo de traza abierto.
+ */
+typedef struct {
+    TraceHeader *header;    /**< Cabecera mapeada */
+    TraceRecord *records;   /**< Registros, a continuación de la cabecera */
+    int64_t mask;           /**< capacity - 1 */
+    size_t mapSize;         /**< Bytes mapeados */
+} TraceFile;
+
+
+/**
+ * @brief Crea (o trunca) un archivo de traza y lo mapea para escribir.
+ *
+ * @param tf Traza a inicializar
+ * @param path Ruta del archivo
+ * @param capacity Registros del anillo, se redondea a potencia de 2
+ * @param params Parámetros de la corrida, se guardan en la cabecera
+ * @return 0 si todo salió bien, -1 si no (errno indica la causa)
+ */
+int openTraceWriter(TraceFile *tf, const char *path, long long capacity, const SimParams *params);
+
+
+/**
+ * @brief Abre un archivo de traza existente para leer.
+ *
+ * @param tf Traza a inicializar
+ * @param path Ruta del archivo
+ * @return 0 si todo salió bien, -1 si no se pudo abrir o no es una traza válida
+ */
+int openTraceReader(TraceFile *tf, const char *path);
+
+
+/**
+ * @brief Guarda un evento. Pueden llamarla varios hilos a la vez.
+ *
+ * @param tf Traza abierta para escribir
+ * @param time Instante en microsegundos
+ * @param code Código del evento
+ * @param vehicle Identificador del vehículo
+ * @param dir Dirección actual
+ * @param window Ventana actual
+ */
+void traceEvent(TraceFile *tf, long long time, char code, int vehicle, int dir, int window);
+
+
+/**
+ * @brief Posición del registro más antiguo que sigue en el archivo.
+ *
+ * @param tf Traza abierta
+ * @return long long Posición; los registros válidos son [traceFirst(), traceEnd())
+ */
+long long traceFirst(const TraceFile *tf);
+
+
+/**
+ * @brief Cantidad de registros escritos desde el inicio.
+ *
+ * @param tf Traza abierta
+ * @return long long
+ */
+long long traceEnd(const TraceFile *tf);
+
+
+/**
+ * @brief Registro en una posición.
+ *
+ * @param tf Traza abierta
+ * @param pos Posición entre traceFirst() y traceEnd()
+ * @return const TraceRecord*
+ */
+const TraceRecord* traceAt(const TraceFile *tf, long long pos);
+
+
+/**
+ * @brief Baja los cambios al disco y libera el mapeo.
+ *
+ * @param tf Traza abierta
+ */
+void closeTrace(TraceFile *tf);
+
+
+#endif